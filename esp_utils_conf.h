@@ -16,9 +16,48 @@
  *  - ESP_UTILS_CHECK_HANDLE_WITH_NONE:      Do nothing when check failed (Minimum code size)
  *  - ESP_UTILS_CHECK_HANDLE_WITH_ERROR_LOG: Print error message when check failed (Recommended)
  *  - ESP_UTILS_CHECK_HANDLE_WITH_ASSERT:    Assert when check failed
+ *
+ * A translation unit can override it by defining `ESP_UTILS_CHECK_LOCAL_HANDLE_METHOD` before including the library
+ * headers
  */
 #define ESP_UTILS_CONF_CHECK_HANDLE_METHOD                  (ESP_UTILS_CHECK_HANDLE_WITH_ERROR_LOG)
 
+/**
+ * @brief Set to 1 to log the failures through an out-of-line cold function which takes a constant call-site
+ *        descriptor, instead of expanding the whole log call at each check. It reduces the code size of the callers.
+ *        It applies to `ESP_UTILS_CHECK_HANDLE_WITH_ERROR_LOG`, selected globally or by
+ *        `ESP_UTILS_CHECK_LOCAL_HANDLE_METHOD`. It is ignored with `ESP_UTILS_CONF_LOG_ENABLE_DICT`, whose call sites
+ *        are already compact
+ */
+#define ESP_UTILS_CONF_CHECK_ENABLE_OUTLINE_REPORT          (1)
+
+/**
+ * @brief Set to 1 to count the failures of each check in a static counter (see `check/esp_utils_check_counter.h`),
+ *        so they can be exported as a compact report even with `ESP_UTILS_CHECK_HANDLE_WITH_NONE`. It doesn't work
+ *        with `ESP_UTILS_CHECK_HANDLE_WITH_ASSERT`
+ */
+#define ESP_UTILS_CONF_CHECK_ENABLE_FAILURE_COUNTER         (0)
+
+/**
+ * @brief Set to 1 to record a short backtrace and a timestamp of each failed check into a RAM ring (see
+ *        `check/esp_utils_check_backtrace.h`), the records can be dumped and symbolized offline by
+ *        `tools/esp_utils_symbolize_backtrace.py`. It doesn't work with `ESP_UTILS_CHECK_HANDLE_WITH_ASSERT`
+ */
+#define ESP_UTILS_CONF_CHECK_ENABLE_BACKTRACE               (0)
+#if ESP_UTILS_CONF_CHECK_ENABLE_BACKTRACE
+
+/**
+ * Maximum number of frames in each record, range [1, 32]
+ */
+#   define ESP_UTILS_CONF_CHECK_BACKTRACE_DEPTH             (8)
+
+/**
+ * Number of records kept in the ring, must be a power of two. The oldest records are overwritten
+ */
+#   define ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE         (16)
+
+#endif // ESP_UTILS_CONF_CHECK_ENABLE_BACKTRACE
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////// Log Configurations //////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -37,6 +76,8 @@
  *  - ESP_UTILS_LOG_LEVEL_WARNING: Error conditions from which recovery measures have been taken
  *  - ESP_UTILS_LOG_LEVEL_ERROR:   Critical errors, software module cannot recover on its own
  *  - ESP_UTILS_LOG_LEVEL_NONE:    No log output (highest level) (Minimum code size)
+ *
+ * A translation unit can override it by defining `ESP_UTILS_LOG_LOCAL_LEVEL` before including the library headers
  */
 #define ESP_UTILS_CONF_LOG_LEVEL                            (ESP_UTILS_LOG_LEVEL_INFO)
 #if ESP_UTILS_CONF_LOG_LEVEL == ESP_UTILS_LOG_LEVEL_DEBUG
@@ -48,6 +89,63 @@
 
 #endif // ESP_UTILS_CONF_LOG_LEVEL
 
+/**
+ * @brief Set to 1 to record the enter/exit timestamps of `ESP_UTILS_LOG_TRACE_GUARD()` scopes into per-thread buffers
+ *        instead of printing them, the records can be exported as Chrome Trace Event JSON (see
+ *        `log/esp_utils_log_trace.hpp`). It works with any log level
+ */
+#define ESP_UTILS_CONF_LOG_ENABLE_TRACE_RECORD              (0)
+#if ESP_UTILS_CONF_LOG_ENABLE_TRACE_RECORD
+
+/**
+ * Number of scopes kept for each thread, older ones are overwritten
+ */
+#   define ESP_UTILS_CONF_LOG_TRACE_RECORD_BUFFER_SIZE      (256)
+
+#endif // ESP_UTILS_CONF_LOG_ENABLE_TRACE_RECORD
+
+/**
+ * @brief Size of the stack buffer used by `ESP_UTILS_LOGx_FMT()` (see `log/esp_utils_log_format.hpp`), longer
+ *        messages will be truncated
+ */
+#define ESP_UTILS_CONF_LOG_FMT_BUFFER_SIZE                  (256)
+
+/**
+ * @brief Set to 1 to route log messages through the registered sinks (see `log/esp_utils_log_sink.h`), so that
+ *        they can be written to several destinations at once (console, file, RAM ring buffer, etc.)
+ */
+#define ESP_UTILS_CONF_LOG_ENABLE_SINK                      (0)
+#if ESP_UTILS_CONF_LOG_ENABLE_SINK
+
+/**
+ * Maximum number of sinks that can be registered at the same time (including the default console sink)
+ */
+#   define ESP_UTILS_CONF_LOG_SINK_MAX_NUM                  (4)
+
+/**
+ * Size of the stack buffer used to format a message before dispatching it to the sinks (bytes).
+ * Longer messages will be truncated
+ */
+#   define ESP_UTILS_CONF_LOG_SINK_BUFFER_SIZE              (256)
+
+#endif // ESP_UTILS_CONF_LOG_ENABLE_SINK
+
+/**
+ * @brief Set to 1 to emit compact binary log frames (see `log/esp_utils_log_dict.h`) instead of formatted text.
+ *        Each frame only carries a call-site ID and the binary-encoded arguments, format strings stay in the firmware
+ *        and are resolved on the host by `tools/esp_utils_log_dict.py`. Can't be used together with log sinks
+ */
+#define ESP_UTILS_CONF_LOG_ENABLE_DICT                      (0)
+#if ESP_UTILS_CONF_LOG_ENABLE_DICT
+
+/**
+ * Maximum payload size of a single frame (bytes), range [16, 255].
+ * Arguments that don't fit will be dropped
+ */
+#   define ESP_UTILS_CONF_LOG_DICT_BUFFER_SIZE              (128)
+
+#endif // ESP_UTILS_CONF_LOG_ENABLE_DICT
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////// Memory Configurations /////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -152,7 +250,7 @@
  * 3. Patch version mismatch: No impact on functionality
  */
 #define ESP_UTILS_CONF_FILE_VERSION_MAJOR 1
-#define ESP_UTILS_CONF_FILE_VERSION_MINOR 5
+#define ESP_UTILS_CONF_FILE_VERSION_MINOR 6
 #define ESP_UTILS_CONF_FILE_VERSION_PATCH 0
 
 // *INDENT-ON*
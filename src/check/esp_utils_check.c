@@ -0,0 +1,38 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdarg.h>
+#include <stdio.h>
+#include "esp_utils_check.h"
+
+// Also built for the global methods without logging, since a translation unit can select it locally
+#if ESP_UTILS_CHECK_OUTLINE_REPORT
+
+// As large as the buffer of the log line, so the message is only truncated by the log implementation
+#if ESP_UTILS_CONF_LOG_ENABLE_SINK
+#define REPORT_MESSAGE_SIZE (ESP_UTILS_CONF_LOG_SINK_BUFFER_SIZE)
+#else
+#define REPORT_MESSAGE_SIZE (ESP_UTILS_CONF_LOG_FMT_BUFFER_SIZE)
+#endif
+
+void esp_utils_check_report(const esp_utils_check_site_t *site, const char *format, ...)
+{
+    if ((site == NULL) || (format == NULL)) {
+        return;
+    }
+
+    // Format the message first, so it can be passed to any log implementation as a single argument
+    char message[REPORT_MESSAGE_SIZE];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    ESP_UTILS_LOGE_IMPL_FUNC(
+        site->tag, "[%s:%04d](%s): %s", esp_utils_log_extract_file_name(site->file), site->line, site->func, message
+    );
+}
+
+#endif // ESP_UTILS_CHECK_OUTLINE_REPORT
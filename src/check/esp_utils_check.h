@@ -3,13 +3,123 @@
  *
  * SPDX-License-Identifier: Apache-2.0
  */
+#pragma once
+
+#include <assert.h>
 #if defined(ESP_PLATFORM)
 #include "esp_err.h"
+#include "esp_compiler.h"
 #endif
 #include "esp_utils_conf_internal.h"
 #include "log/esp_utils_log.h"
 
-#if ESP_UTILS_CONF_CHECK_HANDLE_METHOD == ESP_UTILS_CHECK_HANDLE_WITH_NONE
+/**
+ * ESP-IDF provides these in `esp_compiler.h`, define them for other platforms so the failure branches are still
+ * laid out as cold code
+ */
+#ifndef likely
+#   if defined(__GNUC__)
+#       define likely(x)    __builtin_expect(!!(x), 1)
+#   else
+#       define likely(x)    (x)
+#   endif
+#endif
+#ifndef unlikely
+#   if defined(__GNUC__)
+#       define unlikely(x)  __builtin_expect(!!(x), 0)
+#   else
+#       define unlikely(x)  (x)
+#   endif
+#endif
+
+/**
+ * Check handle method of the current translation unit, define `ESP_UTILS_CHECK_LOCAL_HANDLE_METHOD` before including
+ * the library headers to override `ESP_UTILS_CONF_CHECK_HANDLE_METHOD`, e.g. to keep strict checks in a new module
+ * and remove them from a proven hot path
+ */
+#ifdef ESP_UTILS_CHECK_LOCAL_HANDLE_METHOD
+#   define ESP_UTILS_CHECK_HANDLE_METHOD    (ESP_UTILS_CHECK_LOCAL_HANDLE_METHOD)
+#else
+#   define ESP_UTILS_CHECK_HANDLE_METHOD    (ESP_UTILS_CONF_CHECK_HANDLE_METHOD)
+#endif
+
+#if ESP_UTILS_CONF_CHECK_ENABLE_FAILURE_COUNTER
+#include "esp_utils_check_counter.h"
+#define ESP_UTILS_CHECK_COUNT_FAILURE()     ESP_UTILS_CHECK_COUNTER_INCREMENT()
+#else
+#define ESP_UTILS_CHECK_COUNT_FAILURE()     do { } while(0)
+#endif
+
+#if ESP_UTILS_CONF_CHECK_ENABLE_BACKTRACE
+#include "esp_utils_check_backtrace.h"
+#define ESP_UTILS_CHECK_CAPTURE_FAILURE()   ESP_UTILS_CHECK_BACKTRACE_CAPTURE()
+#else
+#define ESP_UTILS_CHECK_CAPTURE_FAILURE()   do { } while(0)
+#endif
+
+/**
+ * Post-mortem bookkeeping of a failed check, run before it is handled
+ */
+#define ESP_UTILS_CHECK_RECORD_FAILURE() do {   \
+            ESP_UTILS_CHECK_COUNT_FAILURE();    \
+            ESP_UTILS_CHECK_CAPTURE_FAILURE();  \
+        } while(0)
+
+/**
+ * The outline report formats the message at run time, so with the dictionary log encoding each failure would be a
+ * frame carrying its strings. The checks keep their own call-site descriptors with it instead
+ */
+#if ESP_UTILS_CONF_CHECK_ENABLE_OUTLINE_REPORT && !ESP_UTILS_CONF_LOG_ENABLE_DICT
+#   define ESP_UTILS_CHECK_OUTLINE_REPORT   (1)
+#else
+#   define ESP_UTILS_CHECK_OUTLINE_REPORT   (0)
+#endif
+
+/**
+ * The outline report is declared whatever the global method is, since a translation unit can select the error log
+ * method locally (see `ESP_UTILS_CHECK_LOCAL_HANDLE_METHOD`)
+ */
+#if ESP_UTILS_CHECK_OUTLINE_REPORT
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Location of a check, one constant instance is generated for each failure branch
+ */
+typedef struct {
+    const char *tag;    /*!< Log tag of the check */
+    const char *file;   /*!< File of the check */
+    const char *func;   /*!< Function of the check */
+    int line;           /*!< Line of the check */
+} esp_utils_check_site_t;
+
+/**
+ * @brief Log the error message of a failed check, it is kept out of line so the callers only pay for one call
+ *
+ * @param[in] site   Location of the check
+ * @param[in] format Format string of the message
+ * @param[in] ...    Arguments for the format string
+ */
+void esp_utils_check_report(const esp_utils_check_site_t *site, const char *format, ...)
+__attribute__((cold, noinline, format(printf, 2, 3)));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ESP_UTILS_CHECK_OUTLINE_REPORT
+
+#if ESP_UTILS_CHECK_HANDLE_METHOD == ESP_UTILS_CHECK_HANDLE_WITH_NONE
+
+/**
+ * @brief Handle a failed check whose branch is written by the caller, e.g. `ESP_UTILS_TRY()`
+ *
+ * @param fmt Format string for the error message
+ * @param ... Additional arguments for the format string
+ */
+#define ESP_UTILS_CHECK_HANDLE_FAILURE(fmt, ...)    ESP_UTILS_CHECK_RECORD_FAILURE()
 
 /**
  * @brief Check if the pointer is NULL; if NULL, return the specified value.
@@ -21,6 +131,7 @@
  */
 #define ESP_UTILS_CHECK_NULL_RETURN(x, ret, fmt, ...) do { \
             if (unlikely((x) == NULL)) {                          \
+                ESP_UTILS_CHECK_RECORD_FAILURE();       \
                 return ret;                             \
             }                                           \
         } while(0)
@@ -35,6 +146,7 @@
  */
 #define ESP_UTILS_CHECK_NULL_GOTO(x, goto_tag, fmt, ...) do { \
             if (unlikely((x) == NULL)) {                             \
+                ESP_UTILS_CHECK_RECORD_FAILURE();          \
                 goto goto_tag;                             \
             }                                              \
         } while(0)
@@ -48,6 +160,7 @@
  */
 #define ESP_UTILS_CHECK_NULL_EXIT(x, fmt, ...) do { \
             if (unlikely((x) == NULL)) {                   \
+                ESP_UTILS_CHECK_RECORD_FAILURE(); \
                 return;                          \
             }                                    \
         } while(0)
@@ -62,6 +175,7 @@
  */
 #define ESP_UTILS_CHECK_FALSE_RETURN(x, ret, fmt, ...) do { \
             if (unlikely((x) == false)) {                          \
+                ESP_UTILS_CHECK_RECORD_FAILURE();        \
                 return ret;                              \
             }                                            \
         } while(0)
@@ -76,6 +190,7 @@
  */
 #define ESP_UTILS_CHECK_FALSE_GOTO(x, goto_tag, fmt, ...) do { \
             if (unlikely((x) == false)) {                   \
+                ESP_UTILS_CHECK_RECORD_FAILURE();           \
                 goto goto_tag;                              \
             }                                               \
         } while(0)
@@ -89,6 +204,7 @@
  */
 #define ESP_UTILS_CHECK_FALSE_EXIT(x, fmt, ...) do { \
             if (unlikely((x) == false)) {                   \
+                ESP_UTILS_CHECK_RECORD_FAILURE(); \
                 return;                           \
             }                                     \
         } while(0)
@@ -104,6 +220,7 @@
  */
 #define ESP_UTILS_CHECK_ERROR_RETURN(x, ret, fmt, ...) do { \
             if (unlikely((x) != ESP_OK)) {                          \
+                ESP_UTILS_CHECK_RECORD_FAILURE();        \
                 return ret;                              \
             }                                            \
         } while(0)
@@ -118,6 +235,7 @@
  */
 #define ESP_UTILS_CHECK_ERROR_GOTO(x, goto_tag, fmt, ...) do { \
             if (unlikely((x) != ESP_OK)) {                   \
+                ESP_UTILS_CHECK_RECORD_FAILURE();           \
                 goto goto_tag;                              \
             }                                               \
         } while(0)
@@ -131,6 +249,7 @@
  */
 #define ESP_UTILS_CHECK_ERROR_EXIT(x, fmt, ...) do { \
             if (unlikely((x) != ESP_OK)) {                   \
+                ESP_UTILS_CHECK_RECORD_FAILURE(); \
                 return;                           \
             }                                     \
         } while(0)
@@ -152,6 +271,7 @@
         try { \
             x; \
         } catch (const std::exception &e) { \
+            ESP_UTILS_CHECK_RECORD_FAILURE(); \
             return ret; \
         } \
     } while (0)
@@ -168,6 +288,7 @@
         try { \
             x; \
         } catch (const std::exception &e) { \
+            ESP_UTILS_CHECK_RECORD_FAILURE(); \
             goto goto_tag; \
         } \
     } while (0)
@@ -183,6 +304,7 @@
         try { \
             x; \
         } catch (const std::exception &e) { \
+            ESP_UTILS_CHECK_RECORD_FAILURE(); \
             return; \
         } \
     } while (0)
@@ -205,11 +327,32 @@
 
 #else
 
-#ifndef unlikely
-#define unlikely(x)  (x)
-#endif
+#if ESP_UTILS_CHECK_HANDLE_METHOD == ESP_UTILS_CHECK_HANDLE_WITH_ERROR_LOG
 
-#if ESP_UTILS_CONF_CHECK_HANDLE_METHOD == ESP_UTILS_CHECK_HANDLE_WITH_ERROR_LOG
+#if ESP_UTILS_CHECK_OUTLINE_REPORT
+
+#define ESP_UTILS_CHECK_REPORT(fmt, ...) do {                                                          \
+            if (ESP_UTILS_LOG_LEVEL_ERROR >= ESP_UTILS_LOG_CURRENT_LEVEL) {                             \
+                static const esp_utils_check_site_t _esp_utils_check_site_ = {                          \
+                    ESP_UTILS_LOG_TAG, __FILE__, __func__, __LINE__                                     \
+                };                                                                                      \
+                esp_utils_check_report(&_esp_utils_check_site_, fmt, ##__VA_ARGS__);                   \
+            }                                                                                           \
+        } while(0)
+#else
+#define ESP_UTILS_CHECK_REPORT(fmt, ...)    ESP_UTILS_LOGE(fmt, ##__VA_ARGS__)
+#endif // ESP_UTILS_CHECK_OUTLINE_REPORT
+
+/**
+ * @brief Handle a failed check whose branch is written by the caller (log an error), e.g. `ESP_UTILS_TRY()`
+ *
+ * @param fmt Format string for the error message
+ * @param ... Additional arguments for the format string
+ */
+#define ESP_UTILS_CHECK_HANDLE_FAILURE(fmt, ...)    do { \
+            ESP_UTILS_CHECK_RECORD_FAILURE(); \
+            ESP_UTILS_CHECK_REPORT(fmt, ##__VA_ARGS__); \
+        } while(0)
 
 /**
  * @brief Check if the pointer is NULL; if NULL, log an error and return the specified value.
@@ -221,7 +364,8 @@
  */
 #define ESP_UTILS_CHECK_NULL_RETURN(x, ret, fmt, ...) do { \
             if (unlikely((x) == NULL)) {                          \
-                ESP_UTILS_LOGE(fmt, ##__VA_ARGS__);        \
+                ESP_UTILS_CHECK_RECORD_FAILURE();       \
+                ESP_UTILS_CHECK_REPORT(fmt, ##__VA_ARGS__);        \
                 return ret;                             \
             }                                           \
         } while(0)
@@ -236,7 +380,8 @@
  */
 #define ESP_UTILS_CHECK_NULL_GOTO(x, goto_tag, fmt, ...) do { \
             if (unlikely((x) == NULL)) {                             \
-                ESP_UTILS_LOGE(fmt, ##__VA_ARGS__);           \
+                ESP_UTILS_CHECK_RECORD_FAILURE();          \
+                ESP_UTILS_CHECK_REPORT(fmt, ##__VA_ARGS__);           \
                 goto goto_tag;                             \
             }                                              \
         } while(0)
@@ -250,7 +395,8 @@
  */
 #define ESP_UTILS_CHECK_NULL_EXIT(x, fmt, ...) do { \
             if (unlikely((x) == NULL)) {                   \
-                ESP_UTILS_LOGE(fmt, ##__VA_ARGS__); \
+                ESP_UTILS_CHECK_RECORD_FAILURE(); \
+                ESP_UTILS_CHECK_REPORT(fmt, ##__VA_ARGS__); \
                 return;                          \
             }                                    \
         } while(0)
@@ -265,7 +411,8 @@
  */
 #define ESP_UTILS_CHECK_FALSE_RETURN(x, ret, fmt, ...) do { \
             if (unlikely((x) == false)) {                          \
-                ESP_UTILS_LOGE(fmt, ##__VA_ARGS__);         \
+                ESP_UTILS_CHECK_RECORD_FAILURE();        \
+                ESP_UTILS_CHECK_REPORT(fmt, ##__VA_ARGS__);         \
                 return ret;                              \
             }                                            \
         } while(0)
@@ -280,7 +427,8 @@
  */
 #define ESP_UTILS_CHECK_FALSE_GOTO(x, goto_tag, fmt, ...) do { \
             if (unlikely((x) == false)) {                   \
-                ESP_UTILS_LOGE(fmt, ##__VA_ARGS__);            \
+                ESP_UTILS_CHECK_RECORD_FAILURE();           \
+                ESP_UTILS_CHECK_REPORT(fmt, ##__VA_ARGS__);            \
                 goto goto_tag;                              \
             }                                               \
         } while(0)
@@ -294,7 +442,8 @@
  */
 #define ESP_UTILS_CHECK_FALSE_EXIT(x, fmt, ...) do { \
             if (unlikely((x) == false)) {                   \
-                ESP_UTILS_LOGE(fmt, ##__VA_ARGS__);  \
+                ESP_UTILS_CHECK_RECORD_FAILURE(); \
+                ESP_UTILS_CHECK_REPORT(fmt, ##__VA_ARGS__);  \
                 return;                           \
             }                                     \
         } while(0)
@@ -311,7 +460,8 @@
 #define ESP_UTILS_CHECK_ERROR_RETURN(x, ret, fmt, ...) do { \
             esp_err_t _err_ = (x);                        \
             if (unlikely(_err_ != ESP_OK)) {                          \
-                ESP_UTILS_LOGE(fmt " [%s]", ##__VA_ARGS__, esp_err_to_name(_err_)); \
+                ESP_UTILS_CHECK_RECORD_FAILURE();        \
+                ESP_UTILS_CHECK_REPORT(fmt " [%s]", ##__VA_ARGS__, esp_err_to_name(_err_)); \
                 return ret;                              \
             }                                            \
         } while(0)
@@ -327,7 +477,8 @@
 #define ESP_UTILS_CHECK_ERROR_GOTO(x, goto_tag, fmt, ...) do { \
             esp_err_t _err_ = (x);                        \
             if (unlikely(_err_ != ESP_OK)) {                   \
-                ESP_UTILS_LOGE(fmt " [%s]", ##__VA_ARGS__, esp_err_to_name(_err_)); \
+                ESP_UTILS_CHECK_RECORD_FAILURE();           \
+                ESP_UTILS_CHECK_REPORT(fmt " [%s]", ##__VA_ARGS__, esp_err_to_name(_err_)); \
                 goto goto_tag;                              \
             }                                               \
         } while(0)
@@ -342,7 +493,8 @@
 #define ESP_UTILS_CHECK_ERROR_EXIT(x, fmt, ...) do { \
             esp_err_t _err_ = (x);                        \
             if (unlikely(_err_ != ESP_OK)) {                   \
-                ESP_UTILS_LOGE(fmt " [%s]", ##__VA_ARGS__, esp_err_to_name(_err_)); \
+                ESP_UTILS_CHECK_RECORD_FAILURE(); \
+                ESP_UTILS_CHECK_REPORT(fmt " [%s]", ##__VA_ARGS__, esp_err_to_name(_err_)); \
                 return;                           \
             }                                     \
         } while(0)
@@ -364,8 +516,9 @@
         try { \
             x; \
         } catch (const std::exception &e) { \
-            ESP_UTILS_LOGE("Exception caught: %s", e.what()); \
-            ESP_UTILS_LOGE(fmt, ##__VA_ARGS__); \
+            ESP_UTILS_CHECK_RECORD_FAILURE(); \
+            ESP_UTILS_CHECK_REPORT("Exception caught: %s", e.what()); \
+            ESP_UTILS_CHECK_REPORT(fmt, ##__VA_ARGS__); \
             return ret; \
         } \
     } while (0)
@@ -382,8 +535,9 @@
         try { \
             x; \
         } catch (const std::exception &e) { \
-            ESP_UTILS_LOGE("Exception caught: %s", e.what()); \
-            ESP_UTILS_LOGE(fmt, ##__VA_ARGS__); \
+            ESP_UTILS_CHECK_RECORD_FAILURE(); \
+            ESP_UTILS_CHECK_REPORT("Exception caught: %s", e.what()); \
+            ESP_UTILS_CHECK_REPORT(fmt, ##__VA_ARGS__); \
             goto goto_tag; \
         } \
     } while (0)
@@ -399,8 +553,9 @@
         try { \
             x; \
         } catch (const std::exception &e) { \
-            ESP_UTILS_LOGE("Exception caught: %s", e.what()); \
-            ESP_UTILS_LOGE(fmt, ##__VA_ARGS__); \
+            ESP_UTILS_CHECK_RECORD_FAILURE(); \
+            ESP_UTILS_CHECK_REPORT("Exception caught: %s", e.what()); \
+            ESP_UTILS_CHECK_REPORT(fmt, ##__VA_ARGS__); \
             return; \
         } \
     } while (0)
@@ -418,11 +573,13 @@
             __typeof__(min) _min = (min);                          \
             __typeof__(max) _max = (max);                          \
             if ((_x < _min) || (_x > _max)) { \
-                ESP_UTILS_LOGE("Invalid value: %d, should be in range [%d, %d]", _x, _min, _max); \
+                ESP_UTILS_CHECK_REPORT("Invalid value: %d, should be in range [%d, %d]", _x, _min, _max); \
             }                                                      \
         } while(0)
 
-#elif ESP_UTILS_CONF_CHECK_HANDLE_METHOD == ESP_UTILS_CHECK_HANDLE_WITH_ASSERT
+#elif ESP_UTILS_CHECK_HANDLE_METHOD == ESP_UTILS_CHECK_HANDLE_WITH_ASSERT
+
+#define ESP_UTILS_CHECK_HANDLE_FAILURE(fmt, ...)        assert(false)
 
 #define ESP_UTILS_CHECK_NULL_RETURN(x, ...)             assert((x) != NULL)
 #define ESP_UTILS_CHECK_NULL_GOTO(x, goto_tag, ...)     do { \
@@ -493,8 +650,8 @@
             assert((_x >= _min) && (_x <= _max)); \
         } while(0)
 
-#endif // ESP_UTILS_CONF_CHECK_HANDLE_METHOD
-#endif // ESP_UTILS_CONF_CHECK_HANDLE_METHOD
+#endif // ESP_UTILS_CHECK_HANDLE_METHOD
+#endif // ESP_UTILS_CHECK_HANDLE_METHOD
 
 /**
  * @brief Check if the value is within the range [min, max]; if not, log an error and return the specified value.
@@ -0,0 +1,306 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "esp_utils_conf_internal.h"
+#if ESP_UTILS_CONF_CHECK_ENABLE_BACKTRACE
+#include <inttypes.h>
+#include <string.h>
+#if defined(ESP_PLATFORM)
+#include "sdkconfig.h"
+#include "esp_timer.h"
+#   if defined(__XTENSA__)
+#include "esp_cpu.h"
+#include "esp_debug_helpers.h"
+#   elif CONFIG_ESP_SYSTEM_USE_FRAME_POINTER
+#include "esp_memory_utils.h"
+#   endif
+#else
+#include <time.h>
+#   if defined(__has_include)
+#       if __has_include(<unwind.h>)
+#include <unwind.h>
+#define BACKTRACE_USE_UNWIND    (1)
+#       endif
+#   endif
+#endif
+#include "log/esp_utils_log.h"
+#include "esp_utils_check_backtrace.h"
+
+#define RING_MASK           (ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE - 1)
+#define BT_PREFIX           "ESP_UTILS_BT"
+#define BT_LINE_SIZE        (96 + ESP_UTILS_CONF_CHECK_BACKTRACE_DEPTH * 19)
+
+static esp_utils_check_backtrace_record_t records_ring[ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE];
+// Sequence number of the last reserved record, and of the last discarded one
+static uint32_t records_head = 0;
+static uint32_t records_cleared = 0;
+
+static uint64_t get_timestamp_us(void)
+{
+#if defined(ESP_PLATFORM)
+    return (uint64_t)esp_timer_get_time();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+#endif
+}
+
+/*
+ * The frames are stored as call-site addresses (the return address moved back into the call instruction), so they
+ * can be passed to `addr2line` as they are. The frame of `esp_utils_check_backtrace_capture()` itself is skipped
+ */
+#if defined(ESP_PLATFORM) && defined(__XTENSA__)
+
+static inline __attribute__((always_inline)) uint32_t get_frames(uintptr_t *frames)
+{
+    esp_backtrace_frame_t frame = { 0 };
+    uint32_t depth = 0;
+
+    esp_backtrace_get_start(&frame.pc, &frame.sp, &frame.next_pc);
+    // The window registers are spilled by `esp_backtrace_get_start()`, so the callers can be walked from the stack
+    while ((depth < ESP_UTILS_CONF_CHECK_BACKTRACE_DEPTH) && (frame.next_pc != 0) &&
+            esp_backtrace_get_next_frame(&frame)) {
+        frames[depth++] = esp_cpu_process_stack_pc(frame.pc);
+    }
+
+    return depth;
+}
+
+#elif defined(ESP_PLATFORM) && CONFIG_ESP_SYSTEM_USE_FRAME_POINTER
+
+static inline __attribute__((always_inline)) uint32_t get_frames(uintptr_t *frames)
+{
+    uintptr_t fp = (uintptr_t)__builtin_frame_address(0);
+    uint32_t depth = 0;
+
+    // The return address and the previous frame pointer are saved right below the frame pointer
+    while ((depth < ESP_UTILS_CONF_CHECK_BACKTRACE_DEPTH) && esp_stack_ptr_is_sane(fp)) {
+        uintptr_t ra = ((const uintptr_t *)fp)[-1];
+        uintptr_t next_fp = ((const uintptr_t *)fp)[-2];
+        if (ra == 0) {
+            break;
+        }
+        frames[depth++] = ra - 1;
+        if (next_fp <= fp) {
+            break;
+        }
+        fp = next_fp;
+    }
+
+    return depth;
+}
+
+#elif defined(BACKTRACE_USE_UNWIND)
+
+typedef struct {
+    uintptr_t *frames;
+    uint32_t depth;
+    bool skipped;
+} unwind_ctx_t;
+
+static _Unwind_Reason_Code unwind_frame(struct _Unwind_Context *context, void *arg)
+{
+    unwind_ctx_t *ctx = (unwind_ctx_t *)arg;
+    uintptr_t pc = (uintptr_t)_Unwind_GetIP(context);
+
+    if (pc == 0) {
+        return _URC_END_OF_STACK;
+    }
+    if (!ctx->skipped) {
+        ctx->skipped = true;
+        return _URC_NO_REASON;
+    }
+    ctx->frames[ctx->depth++] = pc - 1;
+
+    return (ctx->depth < ESP_UTILS_CONF_CHECK_BACKTRACE_DEPTH) ? _URC_NO_REASON : _URC_END_OF_STACK;
+}
+
+static inline __attribute__((always_inline)) uint32_t get_frames(uintptr_t *frames)
+{
+    unwind_ctx_t ctx = {
+        .frames = frames,
+        .depth = 0,
+        .skipped = false,
+    };
+    _Unwind_Backtrace(unwind_frame, &ctx);
+
+    return ctx.depth;
+}
+
+#else
+
+// Without an unwinder or frame pointers, only the caller can be recorded
+static inline __attribute__((always_inline)) uint32_t get_frames(uintptr_t *frames)
+{
+    frames[0] = (uintptr_t)__builtin_extract_return_addr(__builtin_return_address(0)) - 1;
+
+    return 1;
+}
+
+#endif
+
+void esp_utils_check_backtrace_capture(const char *tag, const char *file, int line)
+{
+    // Reserve a record first, concurrent captures never share one unless the ring is lapped
+    uint32_t seq = __atomic_add_fetch(&records_head, 1, __ATOMIC_RELAXED);
+    esp_utils_check_backtrace_record_t *record = &records_ring[(seq - 1) & RING_MASK];
+
+    // Readers skip the record until the sequence number is published again
+    __atomic_store_n(&record->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    record->timestamp_us = get_timestamp_us();
+    record->tag = tag;
+    record->file = file;
+    record->line = line;
+    record->depth = get_frames(record->frames);
+
+    __atomic_store_n(&record->seq, seq, __ATOMIC_RELEASE);
+}
+
+static bool copy_record(uint32_t seq, esp_utils_check_backtrace_record_t *out)
+{
+    const esp_utils_check_backtrace_record_t *record = &records_ring[(seq - 1) & RING_MASK];
+
+    if (__atomic_load_n(&record->seq, __ATOMIC_ACQUIRE) != seq) {
+        return false;
+    }
+    memcpy(out, record, sizeof(*out));
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+    // Discard the copy if the record has been overwritten meanwhile
+    return (__atomic_load_n(&record->seq, __ATOMIC_RELAXED) == seq) && (out->seq == seq) &&
+           (out->depth <= ESP_UTILS_CONF_CHECK_BACKTRACE_DEPTH);
+}
+
+static uint32_t get_first_seq(uint32_t head)
+{
+    uint32_t cleared = __atomic_load_n(&records_cleared, __ATOMIC_ACQUIRE);
+    uint32_t first = (head > ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE) ?
+                     (head - ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE + 1) : 1;
+
+    return (cleared >= first) ? (cleared + 1) : first;
+}
+
+size_t esp_utils_check_backtrace_read(esp_utils_check_backtrace_record_t *records, size_t max_num)
+{
+    if ((records == NULL) || (max_num == 0)) {
+        return 0;
+    }
+
+    uint32_t head = __atomic_load_n(&records_head, __ATOMIC_ACQUIRE);
+    uint32_t first = get_first_seq(head);
+    if ((head >= first) && ((head - first + 1) > max_num)) {
+        first = head - (uint32_t)max_num + 1;
+    }
+
+    size_t num = 0;
+    for (uint32_t seq = first; (seq != 0) && (seq <= head); seq++) {
+        if (copy_record(seq, &records[num])) {
+            num++;
+        }
+    }
+
+    return num;
+}
+
+static int format_anchor(char *buffer, size_t size)
+{
+    return snprintf(
+               buffer, size, BT_PREFIX " anchor=0x%" PRIxPTR "\n", (uintptr_t)&esp_utils_check_backtrace_capture
+           );
+}
+
+static int format_record(char *buffer, size_t size, const esp_utils_check_backtrace_record_t *record)
+{
+    size_t len = 0;
+    int ret = snprintf(
+                  buffer, size, BT_PREFIX " #%" PRIu32 " t=%" PRIu64 " %s %s:%d bt=", record->seq, record->timestamp_us,
+                  (record->tag != NULL) ? record->tag : "-", esp_utils_log_extract_file_name(record->file), record->line
+              );
+    if (ret < 0) {
+        return ret;
+    }
+    len = ret;
+
+    for (uint32_t i = 0; i < record->depth; i++) {
+        ret = snprintf(
+                  (len < size) ? (buffer + len) : NULL, (len < size) ? (size - len) : 0, "%s0x%" PRIxPTR,
+                  (i > 0) ? " " : "", record->frames[i]
+              );
+        if (ret < 0) {
+            return ret;
+        }
+        len += ret;
+    }
+    ret = snprintf((len < size) ? (buffer + len) : NULL, (len < size) ? (size - len) : 0, "\n");
+
+    return (ret < 0) ? ret : (int)(len + ret);
+}
+
+size_t esp_utils_check_backtrace_export(char *buffer, size_t size)
+{
+    if (buffer == NULL) {
+        size = 0;
+    }
+    if (size > 0) {
+        buffer[0] = '\0';
+    }
+
+    size_t len = 0;
+    int ret = format_anchor(buffer, size);
+    if (ret > 0) {
+        len += ret;
+    }
+
+    uint32_t head = __atomic_load_n(&records_head, __ATOMIC_ACQUIRE);
+    esp_utils_check_backtrace_record_t record;
+    for (uint32_t seq = get_first_seq(head); (seq != 0) && (seq <= head); seq++) {
+        if (!copy_record(seq, &record)) {
+            continue;
+        }
+        ret = format_record((len < size) ? (buffer + len) : NULL, (len < size) ? (size - len) : 0, &record);
+        if (ret > 0) {
+            len += ret;
+        }
+    }
+
+    return len;
+}
+
+size_t esp_utils_check_backtrace_dump(FILE *stream)
+{
+    if (stream == NULL) {
+        return 0;
+    }
+
+    char line[BT_LINE_SIZE];
+    if (format_anchor(line, sizeof(line)) > 0) {
+        fputs(line, stream);
+    }
+
+    size_t num = 0;
+    uint32_t head = __atomic_load_n(&records_head, __ATOMIC_ACQUIRE);
+    esp_utils_check_backtrace_record_t record;
+    for (uint32_t seq = get_first_seq(head); (seq != 0) && (seq <= head); seq++) {
+        if (!copy_record(seq, &record) || (format_record(line, sizeof(line), &record) <= 0)) {
+            continue;
+        }
+        fputs(line, stream);
+        num++;
+    }
+    fflush(stream);
+
+    return num;
+}
+
+void esp_utils_check_backtrace_clear(void)
+{
+    __atomic_store_n(&records_cleared, __atomic_load_n(&records_head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+}
+
+#endif // ESP_UTILS_CONF_CHECK_ENABLE_BACKTRACE
@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "esp_utils_conf_internal.h"
+
+#if ESP_UTILS_CONF_CHECK_ENABLE_BACKTRACE
+
+#if (ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE & (ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE - 1)) != 0
+#error "ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE must be a power of two"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Backtrace record of a failed check
+ *
+ * @note  The frames are raw return addresses, use `tools/esp_utils_symbolize_backtrace.py` with the application ELF
+ *        file to resolve them
+ */
+typedef struct {
+    uint32_t seq;                                               /*!< Sequence number, starts from 1 */
+    uint32_t depth;                                             /*!< Number of valid frames */
+    uint64_t timestamp_us;                                      /*!< Time of the failure since startup */
+    const char *tag;                                            /*!< Log tag of the check */
+    const char *file;                                           /*!< File of the check */
+    int line;                                                   /*!< Line of the check */
+    uintptr_t frames[ESP_UTILS_CONF_CHECK_BACKTRACE_DEPTH];     /*!< Return addresses, the innermost first */
+} esp_utils_check_backtrace_record_t;
+
+/**
+ * @brief Record the backtrace of the caller into the ring, called by `ESP_UTILS_CHECK_BACKTRACE_CAPTURE()`
+ *
+ * @note  On ESP targets it is lock-free and allocation-free, so it can be called from any context (including ISRs).
+ *        On other platforms the frames are collected by `_Unwind_Backtrace()`, which may lock or allocate, so it
+ *        must not be called from a signal handler
+ *
+ * @param[in] tag  Log tag of the check
+ * @param[in] file File of the check
+ * @param[in] line Line of the check
+ */
+void esp_utils_check_backtrace_capture(const char *tag, const char *file, int line) __attribute__((cold, noinline));
+
+/**
+ * @brief Copy the records which are still in the ring (oldest first). A record which is being overwritten is skipped
+ *
+ * @param[out] records Output records
+ * @param[in]  max_num Maximum number of records to copy, the most recent ones are kept if it is too small
+ *
+ * @return Number of copied records
+ */
+size_t esp_utils_check_backtrace_read(esp_utils_check_backtrace_record_t *records, size_t max_num);
+
+/**
+ * @brief Export the records (oldest first) as text lines, which can be symbolized by
+ *        `tools/esp_utils_symbolize_backtrace.py`:
+ *          - `ESP_UTILS_BT anchor=<address>\n`, runtime address of `esp_utils_check_backtrace_capture()`, used to
+ *            relocate position-independent executables
+ *          - `ESP_UTILS_BT #<seq> t=<us> <tag> <file>:<line> bt=<address> <address> ...\n`
+ *
+ * @param[out] buffer Output buffer, always null-terminated (if `size` > 0)
+ * @param[in]  size   Size of `buffer`
+ *
+ * @return Length of the full report (excluding the terminator), it can be larger than `size` if truncated
+ */
+size_t esp_utils_check_backtrace_export(char *buffer, size_t size);
+
+/**
+ * @brief Write the records to a stream in the same format as `esp_utils_check_backtrace_export()`, without any
+ *        extra buffer
+ *
+ * @param[in] stream Output stream, e.g. `stdout`
+ *
+ * @return Number of dumped records
+ */
+size_t esp_utils_check_backtrace_dump(FILE *stream);
+
+/**
+ * @brief Discard all records
+ */
+void esp_utils_check_backtrace_clear(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @brief Record the backtrace of the current check
+ */
+#define ESP_UTILS_CHECK_BACKTRACE_CAPTURE() \
+        esp_utils_check_backtrace_capture(ESP_UTILS_LOG_TAG, __FILE__, __LINE__)
+
+#endif // ESP_UTILS_CONF_CHECK_ENABLE_BACKTRACE
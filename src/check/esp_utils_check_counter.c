@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "esp_utils_conf_internal.h"
+#if ESP_UTILS_CONF_CHECK_ENABLE_FAILURE_COUNTER
+#include <stdio.h>
+#include "log/esp_utils_log.h"
+#include "esp_utils_check_counter.h"
+
+// Counters are only added at the head and never removed, so readers can walk the list without a lock
+static esp_utils_check_counter_t *counters_head = NULL;
+
+void esp_utils_check_counter_link(esp_utils_check_counter_t *counter)
+{
+    if ((counter == NULL) || __atomic_exchange_n(&counter->linked, true, __ATOMIC_ACQ_REL)) {
+        return;
+    }
+
+    esp_utils_check_counter_t *head = __atomic_load_n(&counters_head, __ATOMIC_RELAXED);
+    do {
+        counter->next = head;
+    } while (!__atomic_compare_exchange_n(
+                 &counters_head, &head, counter, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED
+             ));
+}
+
+size_t esp_utils_check_counter_foreach(esp_utils_check_counter_func_t func, void *user_ctx)
+{
+    size_t visited = 0;
+
+    if (func == NULL) {
+        return 0;
+    }
+
+    for (esp_utils_check_counter_t *counter = __atomic_load_n(&counters_head, __ATOMIC_ACQUIRE); counter != NULL;
+            counter = counter->next) {
+        uint32_t count = __atomic_load_n(&counter->count, __ATOMIC_RELAXED);
+        if (count == 0) {
+            continue;
+        }
+        visited++;
+        if (!func(counter, count, user_ctx)) {
+            break;
+        }
+    }
+
+    return visited;
+}
+
+typedef struct {
+    char *buffer;
+    size_t size;
+    size_t len;
+} export_ctx_t;
+
+static bool export_counter(const esp_utils_check_counter_t *counter, uint32_t count, void *user_ctx)
+{
+    export_ctx_t *ctx = (export_ctx_t *)user_ctx;
+    size_t room = (ctx->len < ctx->size) ? (ctx->size - ctx->len) : 0;
+
+    int ret = snprintf(
+                  (room > 0) ? (ctx->buffer + ctx->len) : NULL, room, "%s %s:%d %u\n", counter->tag,
+                  esp_utils_log_extract_file_name(counter->file), counter->line, (unsigned)count
+              );
+    if (ret > 0) {
+        ctx->len += ret;
+    }
+
+    return true;
+}
+
+size_t esp_utils_check_counter_export(char *buffer, size_t size)
+{
+    export_ctx_t ctx = {
+        .buffer = buffer,
+        .size = (buffer != NULL) ? size : 0,
+        .len = 0,
+    };
+
+    if (ctx.size > 0) {
+        buffer[0] = '\0';
+    }
+    esp_utils_check_counter_foreach(export_counter, &ctx);
+
+    return ctx.len;
+}
+
+static bool sum_counter(const esp_utils_check_counter_t *counter, uint32_t count, void *user_ctx)
+{
+    (void)counter;
+    *(uint32_t *)user_ctx += count;
+
+    return true;
+}
+
+uint32_t esp_utils_check_counter_get_total(void)
+{
+    uint32_t total = 0;
+
+    esp_utils_check_counter_foreach(sum_counter, &total);
+
+    return total;
+}
+
+void esp_utils_check_counter_reset(void)
+{
+    for (esp_utils_check_counter_t *counter = __atomic_load_n(&counters_head, __ATOMIC_ACQUIRE); counter != NULL;
+            counter = counter->next) {
+        __atomic_store_n(&counter->count, 0, __ATOMIC_RELAXED);
+    }
+}
+
+#endif // ESP_UTILS_CONF_CHECK_ENABLE_FAILURE_COUNTER
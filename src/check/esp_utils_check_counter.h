@@ -0,0 +1,97 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_utils_conf_internal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Failure counter of a check, one static instance is generated for each check
+ *
+ * @note  A counter is linked into the global list on its first failure, so only the checks which have failed are
+ *        visited by `esp_utils_check_counter_foreach()`
+ */
+typedef struct esp_utils_check_counter {
+    const char *tag;                        /*!< Log tag of the check */
+    const char *file;                       /*!< File of the check */
+    int line;                               /*!< Line of the check */
+    uint32_t count;                         /*!< Number of failures, access it with atomic operations */
+    bool linked;                            /*!< Set once the counter is in the list */
+    struct esp_utils_check_counter *next;   /*!< Next counter in the list */
+} esp_utils_check_counter_t;
+
+/**
+ * @brief Function called for each counter
+ *
+ * @param[in] counter  Counter of a check
+ * @param[in] count    Number of failures read from the counter
+ * @param[in] user_ctx User context passed to `esp_utils_check_counter_foreach()`
+ *
+ * @return true to continue, false to stop
+ */
+typedef bool (*esp_utils_check_counter_func_t)(const esp_utils_check_counter_t *counter, uint32_t count, void *user_ctx);
+
+/**
+ * @brief Link a counter into the global list, called by `ESP_UTILS_CHECK_COUNTER_INCREMENT()` on the first failure
+ *
+ * @param[in] counter Counter to link
+ */
+void esp_utils_check_counter_link(esp_utils_check_counter_t *counter) __attribute__((cold, noinline));
+
+/**
+ * @brief Call `func` for each check which has failed since startup (or the last reset), it is lock-free and can be
+ *        called while other tasks are running checks
+ *
+ * @param[in] func     Function to call
+ * @param[in] user_ctx User context passed to `func`
+ *
+ * @return Number of visited counters
+ */
+size_t esp_utils_check_counter_foreach(esp_utils_check_counter_func_t func, void *user_ctx);
+
+/**
+ * @brief Export the non-zero counters as compact text lines: `<tag> <file>:<line> <count>\n`
+ *
+ * @param[out] buffer Output buffer, always null-terminated (if `size` > 0)
+ * @param[in]  size   Size of `buffer`
+ *
+ * @return Length of the full report (excluding the terminator), it can be larger than `size` if truncated
+ */
+size_t esp_utils_check_counter_export(char *buffer, size_t size);
+
+/**
+ * @brief Get the total number of failures of all checks
+ *
+ * @return Total number of failures
+ */
+uint32_t esp_utils_check_counter_get_total(void);
+
+/**
+ * @brief Reset all counters to zero, they stay in the list
+ */
+void esp_utils_check_counter_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @brief Count a failure of the current check, the formatting of the location is only done when exporting
+ */
+#define ESP_UTILS_CHECK_COUNTER_INCREMENT() do {                                                        \
+            static esp_utils_check_counter_t _esp_utils_check_counter_ = {                              \
+                ESP_UTILS_LOG_TAG, __FILE__, __LINE__, 0, false, NULL                                   \
+            };                                                                                          \
+            if (__atomic_fetch_add(&_esp_utils_check_counter_.count, 1, __ATOMIC_RELAXED) == 0) {       \
+                esp_utils_check_counter_link(&_esp_utils_check_counter_);                               \
+            }                                                                                           \
+        } while(0)
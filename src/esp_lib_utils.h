@@ -15,6 +15,13 @@
 
 /* Log */
 #include "log/esp_utils_log.h"
+#include "log/esp_utils_log_ring.h"
+#if ESP_UTILS_CONF_LOG_ENABLE_SINK
+#   include "log/esp_utils_log_sink.h"
+#endif
+#if ESP_UTILS_CONF_LOG_ENABLE_DICT
+#   include "log/esp_utils_log_dict.h"
+#endif
 
 /* Memory */
 #include "memory/esp_utils_mem.h"
@@ -23,13 +30,18 @@
 
 /* Log */
 #include "log/esp_utils_log.hpp"
+#include "log/esp_utils_log_format.hpp"
 
 /* Thread */
-#include "thread/esp_utils_thread.hpp"
+#if defined(ESP_PLATFORM)
+#   include "thread/esp_utils_thread.hpp"
+#endif
 
 /* More */
 #include "more/esp_utils_value_guard.hpp"
 #include "more/esp_utils_function_guard.hpp"
+#include "more/esp_utils_inplace_function.hpp"
+#include "more/esp_utils_expected.hpp"
 #if ESP_UTILS_CONF_PLUGIN_SUPPORT
 #   include "more/esp_utils_plugin_registry.hpp"
 #endif
@@ -17,6 +17,48 @@
 #   endif
 #endif
 
+#ifndef ESP_UTILS_CONF_CHECK_ENABLE_OUTLINE_REPORT
+#   ifdef CONFIG_ESP_UTILS_CONF_CHECK_ENABLE_OUTLINE_REPORT
+#       define ESP_UTILS_CONF_CHECK_ENABLE_OUTLINE_REPORT   CONFIG_ESP_UTILS_CONF_CHECK_ENABLE_OUTLINE_REPORT
+#   else
+#       define ESP_UTILS_CONF_CHECK_ENABLE_OUTLINE_REPORT   (0)
+#   endif
+#endif
+
+#ifndef ESP_UTILS_CONF_CHECK_ENABLE_FAILURE_COUNTER
+#   ifdef CONFIG_ESP_UTILS_CONF_CHECK_ENABLE_FAILURE_COUNTER
+#       define ESP_UTILS_CONF_CHECK_ENABLE_FAILURE_COUNTER  CONFIG_ESP_UTILS_CONF_CHECK_ENABLE_FAILURE_COUNTER
+#   else
+#       define ESP_UTILS_CONF_CHECK_ENABLE_FAILURE_COUNTER  (0)
+#   endif
+#endif
+
+#ifndef ESP_UTILS_CONF_CHECK_ENABLE_BACKTRACE
+#   ifdef CONFIG_ESP_UTILS_CONF_CHECK_ENABLE_BACKTRACE
+#       define ESP_UTILS_CONF_CHECK_ENABLE_BACKTRACE    CONFIG_ESP_UTILS_CONF_CHECK_ENABLE_BACKTRACE
+#   else
+#       define ESP_UTILS_CONF_CHECK_ENABLE_BACKTRACE    (0)
+#   endif
+#endif
+
+#if ESP_UTILS_CONF_CHECK_ENABLE_BACKTRACE
+#   ifndef ESP_UTILS_CONF_CHECK_BACKTRACE_DEPTH
+#       ifdef CONFIG_ESP_UTILS_CONF_CHECK_BACKTRACE_DEPTH
+#           define ESP_UTILS_CONF_CHECK_BACKTRACE_DEPTH     CONFIG_ESP_UTILS_CONF_CHECK_BACKTRACE_DEPTH
+#       else
+#           define ESP_UTILS_CONF_CHECK_BACKTRACE_DEPTH     (8)
+#       endif
+#   endif
+
+#   ifndef ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE
+#       ifdef CONFIG_ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE
+#           define ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE CONFIG_ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE
+#       else
+#           define ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE (16)
+#       endif
+#   endif
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////// LOG Configurations //////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -46,6 +88,76 @@
 #   endif
 #endif
 
+#ifndef ESP_UTILS_CONF_LOG_ENABLE_TRACE_RECORD
+#   ifdef CONFIG_ESP_UTILS_CONF_LOG_ENABLE_TRACE_RECORD
+#       define ESP_UTILS_CONF_LOG_ENABLE_TRACE_RECORD   CONFIG_ESP_UTILS_CONF_LOG_ENABLE_TRACE_RECORD
+#   else
+#       define ESP_UTILS_CONF_LOG_ENABLE_TRACE_RECORD   (0)
+#   endif
+#endif
+
+#if ESP_UTILS_CONF_LOG_ENABLE_TRACE_RECORD
+#   ifndef ESP_UTILS_CONF_LOG_TRACE_RECORD_BUFFER_SIZE
+#       ifdef CONFIG_ESP_UTILS_CONF_LOG_TRACE_RECORD_BUFFER_SIZE
+#           define ESP_UTILS_CONF_LOG_TRACE_RECORD_BUFFER_SIZE  CONFIG_ESP_UTILS_CONF_LOG_TRACE_RECORD_BUFFER_SIZE
+#       else
+#           define ESP_UTILS_CONF_LOG_TRACE_RECORD_BUFFER_SIZE  (256)
+#       endif
+#   endif
+#endif
+
+#ifndef ESP_UTILS_CONF_LOG_FMT_BUFFER_SIZE
+#   ifdef CONFIG_ESP_UTILS_CONF_LOG_FMT_BUFFER_SIZE
+#       define ESP_UTILS_CONF_LOG_FMT_BUFFER_SIZE   CONFIG_ESP_UTILS_CONF_LOG_FMT_BUFFER_SIZE
+#   else
+#       define ESP_UTILS_CONF_LOG_FMT_BUFFER_SIZE   (256)
+#   endif
+#endif
+
+#ifndef ESP_UTILS_CONF_LOG_ENABLE_SINK
+#   ifdef CONFIG_ESP_UTILS_CONF_LOG_ENABLE_SINK
+#       define ESP_UTILS_CONF_LOG_ENABLE_SINK       CONFIG_ESP_UTILS_CONF_LOG_ENABLE_SINK
+#   else
+#       define ESP_UTILS_CONF_LOG_ENABLE_SINK       (0)
+#   endif
+#endif
+
+#if ESP_UTILS_CONF_LOG_ENABLE_SINK
+#   ifndef ESP_UTILS_CONF_LOG_SINK_MAX_NUM
+#       ifdef CONFIG_ESP_UTILS_CONF_LOG_SINK_MAX_NUM
+#           define ESP_UTILS_CONF_LOG_SINK_MAX_NUM      CONFIG_ESP_UTILS_CONF_LOG_SINK_MAX_NUM
+#       else
+#           define ESP_UTILS_CONF_LOG_SINK_MAX_NUM      (4)
+#       endif
+#   endif
+
+#   ifndef ESP_UTILS_CONF_LOG_SINK_BUFFER_SIZE
+#       ifdef CONFIG_ESP_UTILS_CONF_LOG_SINK_BUFFER_SIZE
+#           define ESP_UTILS_CONF_LOG_SINK_BUFFER_SIZE  CONFIG_ESP_UTILS_CONF_LOG_SINK_BUFFER_SIZE
+#       else
+#           define ESP_UTILS_CONF_LOG_SINK_BUFFER_SIZE  (256)
+#       endif
+#   endif
+#endif
+
+#ifndef ESP_UTILS_CONF_LOG_ENABLE_DICT
+#   ifdef CONFIG_ESP_UTILS_CONF_LOG_ENABLE_DICT
+#       define ESP_UTILS_CONF_LOG_ENABLE_DICT       CONFIG_ESP_UTILS_CONF_LOG_ENABLE_DICT
+#   else
+#       define ESP_UTILS_CONF_LOG_ENABLE_DICT       (0)
+#   endif
+#endif
+
+#if ESP_UTILS_CONF_LOG_ENABLE_DICT
+#   ifndef ESP_UTILS_CONF_LOG_DICT_BUFFER_SIZE
+#       ifdef CONFIG_ESP_UTILS_CONF_LOG_DICT_BUFFER_SIZE
+#           define ESP_UTILS_CONF_LOG_DICT_BUFFER_SIZE  CONFIG_ESP_UTILS_CONF_LOG_DICT_BUFFER_SIZE
+#       else
+#           define ESP_UTILS_CONF_LOG_DICT_BUFFER_SIZE  (128)
+#       endif
+#   endif
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////// Memory Configurations /////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
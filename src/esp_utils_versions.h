@@ -12,5 +12,5 @@
 
 /* File `esp_utils_conf.h` */
 #define ESP_UTILS_CONF_VERSION_MAJOR 1
-#define ESP_UTILS_CONF_VERSION_MINOR 5
+#define ESP_UTILS_CONF_VERSION_MINOR 6
 #define ESP_UTILS_CONF_VERSION_PATCH 0
@@ -8,7 +8,13 @@
 #include <stdio.h>
 #include <string.h>
 #include "esp_utils_conf_internal.h"
-#if ESP_UTILS_CONF_LOG_IMPL_TYPE == ESP_UTILS_LOG_IMPL_STDLIB
+#if ESP_UTILS_CONF_LOG_ENABLE_DICT && ESP_UTILS_CONF_LOG_ENABLE_SINK
+#   error "Log sinks and dictionary log encoding can't be enabled at the same time"
+#elif ESP_UTILS_CONF_LOG_ENABLE_DICT
+#   include "impl/esp_utils_log_impl_dict.h"
+#elif ESP_UTILS_CONF_LOG_ENABLE_SINK
+#   include "impl/esp_utils_log_impl_sink.h"
+#elif ESP_UTILS_CONF_LOG_IMPL_TYPE == ESP_UTILS_LOG_IMPL_STDLIB
 #   include "impl/esp_utils_log_impl_std.h"
 #elif ESP_UTILS_CONF_LOG_IMPL_TYPE == ESP_UTILS_LOG_IMPL_ESP
 #   include "impl/esp_utils_log_impl_esp.h"
@@ -20,6 +26,16 @@
 #   define ESP_UTILS_LOG_TAG "Utils"
 #endif
 
+/**
+ * Log level of the current translation unit, define `ESP_UTILS_LOG_LOCAL_LEVEL` before including the library headers
+ * to override `ESP_UTILS_CONF_LOG_LEVEL`. With `ESP_UTILS_LOG_IMPL_ESP`, the ESP-IDF log level still applies
+ */
+#ifdef ESP_UTILS_LOG_LOCAL_LEVEL
+#   define ESP_UTILS_LOG_CURRENT_LEVEL  (ESP_UTILS_LOG_LOCAL_LEVEL)
+#else
+#   define ESP_UTILS_LOG_CURRENT_LEVEL  (ESP_UTILS_CONF_LOG_LEVEL)
+#endif
+
 #define ESP_UTILS_LOG_LEVEL(level, format, ...) do {                                                    \
         if      (level == ESP_UTILS_LOG_LEVEL_DEBUG)   { ESP_UTILS_LOGD_IMPL(ESP_UTILS_LOG_TAG, format, ##__VA_ARGS__); }  \
         else if (level == ESP_UTILS_LOG_LEVEL_INFO)    { ESP_UTILS_LOGI_IMPL(ESP_UTILS_LOG_TAG, format, ##__VA_ARGS__); }  \
@@ -29,7 +45,7 @@
     } while(0)
 
 #define ESP_UTILS_LOG_LEVEL_LOCAL(level, format, ...) do {                                          \
-        if (level >= ESP_UTILS_CONF_LOG_LEVEL) ESP_UTILS_LOG_LEVEL(level, format, ##__VA_ARGS__); \
+        if (level >= ESP_UTILS_LOG_CURRENT_LEVEL) ESP_UTILS_LOG_LEVEL(level, format, ##__VA_ARGS__); \
     } while(0)
 
 /**
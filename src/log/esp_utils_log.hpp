@@ -20,6 +20,9 @@
 #endif
 
 #include "esp_utils_log.h"
+#if ESP_UTILS_CONF_LOG_ENABLE_TRACE_RECORD
+#   include "esp_utils_log_trace.hpp"
+#endif
 
 namespace esp_utils {
 namespace detail {
@@ -173,7 +176,16 @@ private:
 // The following macros are deprecated, please use `ESP_UTILS_LOG_TRACE_GUARD()` instead
 #   define ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS() ESP_UTILS_LOGD("(@%p) Enter", this)
 #   define ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS()  ESP_UTILS_LOGD("(@%p) Exit", this)
+#else
+#   define ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS()
+#   define ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS()
+#endif
 
+#if ESP_UTILS_CONF_LOG_ENABLE_TRACE_RECORD
+// Record the scope duration instead of printing enter/exit messages, see `esp_utils_log_trace.hpp`
+#   define ESP_UTILS_LOG_TRACE_GUARD()           ESP_UTILS_LOG_TRACE_RECORD_GUARD(nullptr)
+#   define ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS() ESP_UTILS_LOG_TRACE_RECORD_GUARD(this)
+#elif ESP_UTILS_CONF_ENABLE_LOG_TRACE
 #   if ESP_UTILS_LOG_CXX20_SUPPORT
 #       define ESP_UTILS_LOG_MAKE_FS(str) []{ constexpr esp_utils::detail::FixedString<sizeof(str)> s(str); return s; }()
 #       define ESP_UTILS_LOG_TRACE_GUARD()           esp_utils::detail::log_trace_guard<ESP_UTILS_LOG_MAKE_FS(ESP_UTILS_LOG_TAG)> _log_trace_guard_{}
@@ -183,8 +195,6 @@ private:
 #       define ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS() esp_utils::detail::log_trace_guard _log_trace_guard_{ESP_UTILS_LOG_TAG, __func__, __FILE__, __LINE__, this}
 #   endif
 #else
-#   define ESP_UTILS_LOG_TRACE_ENTER_WITH_THIS()
-#   define ESP_UTILS_LOG_TRACE_EXIT_WITH_THIS()
 #   define ESP_UTILS_LOG_TRACE_GUARD()
 #   define ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS()
 #endif
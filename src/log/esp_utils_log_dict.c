@@ -0,0 +1,275 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "esp_utils_conf_internal.h"
+#if ESP_UTILS_CONF_LOG_ENABLE_DICT
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "esp_utils_log_dict.h"
+
+#define FRAME_PAYLOAD_SIZE  (ESP_UTILS_CONF_LOG_DICT_BUFFER_SIZE)
+// Worst case: every byte after SYNC is escaped
+#define FRAME_BUFFER_SIZE   (1 + 2 * (FRAME_PAYLOAD_SIZE + 2))
+
+typedef struct {
+    uint8_t data[FRAME_PAYLOAD_SIZE];
+    size_t len;
+    bool full;
+} payload_t;
+
+const esp_utils_log_dict_site_t esp_utils_log_dict_anchor = {
+    ESP_UTILS_LOG_DICT_MAGIC, ESP_UTILS_LOG_LEVEL_NONE, 0, 0, NULL, NULL, NULL, NULL
+};
+
+static void stdout_output(void *user_ctx, const uint8_t *data, size_t len)
+{
+    (void)user_ctx;
+    fwrite(data, 1, len, stdout);
+    fflush(stdout);
+}
+
+static esp_utils_log_dict_output_func_t output_func = stdout_output;
+static void *output_ctx = NULL;
+
+static void put_bytes(payload_t *payload, const void *data, size_t len)
+{
+    if (payload->full || (len > (FRAME_PAYLOAD_SIZE - payload->len))) {
+        payload->full = true;
+        return;
+    }
+    memcpy(payload->data + payload->len, data, len);
+    payload->len += len;
+}
+
+static void put_varint(payload_t *payload, uint64_t value)
+{
+    uint8_t buffer[10];
+    size_t len = 0;
+
+    do {
+        buffer[len] = (uint8_t)(value & 0x7F);
+        value >>= 7;
+        if (value != 0) {
+            buffer[len] |= 0x80;
+        }
+        len++;
+    } while (value != 0);
+    put_bytes(payload, buffer, len);
+}
+
+static void put_zigzag(payload_t *payload, int64_t value)
+{
+    put_varint(payload, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+static void put_string(payload_t *payload, const char *str, int precision)
+{
+    if (str == NULL) {
+        str = "(null)";
+    }
+
+    size_t len = (precision >= 0) ? strnlen(str, (size_t)precision) : strlen(str);
+    // Truncate long strings instead of dropping them, keep room for the length
+    size_t room = (FRAME_PAYLOAD_SIZE - payload->len);
+    room = (room > 2) ? (room - 2) : 0;
+    if (len > room) {
+        len = room;
+    }
+    put_varint(payload, len);
+    put_bytes(payload, str, len);
+}
+
+static void put_double(payload_t *payload, double value)
+{
+    uint64_t bits = 0;
+    uint8_t buffer[sizeof(bits)];
+
+    memcpy(&bits, &value, sizeof(bits));
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = (uint8_t)(bits >> (8 * i));
+    }
+    put_bytes(payload, buffer, sizeof(buffer));
+}
+
+/**
+ * Walk the format string like `printf()` does and encode each argument according to its conversion, the decoder
+ * parses the same format string to read them back
+ */
+static void put_args(payload_t *payload, const char *format, va_list args)
+{
+    const char *p = format;
+
+    while (!payload->full && (*p != '\0')) {
+        if (*p++ != '%') {
+            continue;
+        }
+        if (*p == '%') {
+            p++;
+            continue;
+        }
+
+        // Flags
+        while ((*p != '\0') && (strchr("-+ #0'", *p) != NULL)) {
+            p++;
+        }
+        // Width
+        if (*p == '*') {
+            put_zigzag(payload, va_arg(args, int));
+            p++;
+        } else {
+            while ((*p >= '0') && (*p <= '9')) {
+                p++;
+            }
+        }
+        // Precision
+        int precision = -1;
+        if (*p == '.') {
+            p++;
+            precision = 0;
+            if (*p == '*') {
+                precision = va_arg(args, int);
+                put_zigzag(payload, precision);
+                p++;
+            } else {
+                while ((*p >= '0') && (*p <= '9')) {
+                    precision = precision * 10 + (*p++ - '0');
+                }
+            }
+        }
+        // Length modifier
+        char length = 0;
+        if ((p[0] == 'h') && (p[1] == 'h')) {
+            length = 'H';
+            p += 2;
+        } else if ((p[0] == 'l') && (p[1] == 'l')) {
+            length = 'q';
+            p += 2;
+        } else if ((*p != '\0') && (strchr("hljztLq", *p) != NULL)) {
+            length = *p++;
+        }
+
+        switch (*p++) {
+        case 'd':
+        case 'i': {
+            int64_t value = 0;
+            switch (length) {
+            case 'l': value = va_arg(args, long); break;
+            case 'q': value = va_arg(args, long long); break;
+            case 'j': value = va_arg(args, intmax_t); break;
+            case 'z': value = (int64_t)va_arg(args, size_t); break;
+            case 't': value = va_arg(args, ptrdiff_t); break;
+            default: value = va_arg(args, int); break;
+            }
+            put_zigzag(payload, value);
+            break;
+        }
+        case 'u':
+        case 'o':
+        case 'x':
+        case 'X':
+        case 'c': {
+            uint64_t value = 0;
+            switch (length) {
+            case 'H': value = (unsigned char)va_arg(args, unsigned int); break;
+            case 'h': value = (unsigned short)va_arg(args, unsigned int); break;
+            case 'l': value = va_arg(args, unsigned long); break;
+            case 'q': value = va_arg(args, unsigned long long); break;
+            case 'j': value = va_arg(args, uintmax_t); break;
+            case 'z': value = va_arg(args, size_t); break;
+            case 't': value = (uint64_t)va_arg(args, ptrdiff_t); break;
+            default: value = va_arg(args, unsigned int); break;
+            }
+            put_varint(payload, value);
+            break;
+        }
+        case 'p':
+            put_varint(payload, (uintptr_t)va_arg(args, void *));
+            break;
+        case 'f':
+        case 'F':
+        case 'e':
+        case 'E':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            put_double(payload, (length == 'L') ? (double)va_arg(args, long double) : va_arg(args, double));
+            break;
+        case 's':
+            put_string(payload, va_arg(args, const char *), precision);
+            break;
+        case 'n':
+            (void)va_arg(args, void *);
+            break;
+        default:
+            // Unknown conversion, the remaining arguments can't be located
+            return;
+        }
+    }
+}
+
+static size_t put_escaped(uint8_t *frame, size_t len, uint8_t byte)
+{
+    if ((byte == ESP_UTILS_LOG_DICT_SYNC) || (byte == ESP_UTILS_LOG_DICT_ESCAPE) || (byte == '\n')) {
+        frame[len++] = ESP_UTILS_LOG_DICT_ESCAPE;
+        byte ^= ESP_UTILS_LOG_DICT_ESCAPE_XOR;
+    }
+    frame[len++] = byte;
+
+    return len;
+}
+
+void esp_utils_log_dict_set_output(esp_utils_log_dict_output_func_t func, void *user_ctx)
+{
+    output_ctx = user_ctx;
+    output_func = (func != NULL) ? func : stdout_output;
+}
+
+void esp_utils_log_dict_writev(const esp_utils_log_dict_site_t *site, const char *tag, const char *format, va_list args)
+{
+    if (site == NULL) {
+        return;
+    }
+
+    payload_t payload = { .len = 0, .full = false };
+    intptr_t distance = ((const char *)site - (const char *)&esp_utils_log_dict_anchor) / 4;
+    put_zigzag(&payload, distance);
+    if (site->flags & ESP_UTILS_LOG_DICT_FLAG_RUNTIME_TAG) {
+        put_string(&payload, tag, -1);
+    }
+    put_args(&payload, format, args);
+
+    uint8_t frame[FRAME_BUFFER_SIZE];
+    uint8_t checksum = 0;
+    size_t len = 0;
+    frame[len++] = ESP_UTILS_LOG_DICT_SYNC;
+    len = put_escaped(frame, len, (uint8_t)payload.len);
+    for (size_t i = 0; i < payload.len; i++) {
+        checksum += payload.data[i];
+        len = put_escaped(frame, len, payload.data[i]);
+    }
+    len = put_escaped(frame, len, checksum);
+
+    output_func(output_ctx, frame, len);
+}
+
+void esp_utils_log_dict_write(const esp_utils_log_dict_site_t *site, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    esp_utils_log_dict_writev(site, NULL, format, args);
+    va_end(args);
+}
+
+void esp_utils_log_dict_write_tag(const esp_utils_log_dict_site_t *site, const char *tag, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    esp_utils_log_dict_writev(site, tag, format, args);
+    va_end(args);
+}
+
+#endif // ESP_UTILS_CONF_LOG_ENABLE_DICT
@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Layout of a frame (all bytes after `SYNC` are escaped, see below):
+ *
+ *        SYNC | payload length (1 byte) | payload | checksum (1 byte, sum of the payload bytes)
+ *
+ *        The payload starts with the call-site ID, which is the zigzag varint of the distance (in 4-byte units) between
+ *        the call-site descriptor and `esp_utils_log_dict_anchor`, followed by the arguments in format string order:
+ *        - integers, characters and pointers: varint (zigzag varint for signed conversions)
+ *        - floating point numbers: 8-byte little-endian IEEE 754 double
+ *        - strings: varint length followed by the characters
+ *        - `*` width and precision: zigzag varint
+ *
+ *        Bytes `SYNC`, `ESCAPE` and '\n' are written as `ESCAPE` followed by the byte XOR `ESCAPE_XOR`, so frames never
+ *        contain a newline (which some consoles convert to "\r\n") and the decoder can always resynchronize.
+ */
+#define ESP_UTILS_LOG_DICT_SYNC         (0xA5)
+#define ESP_UTILS_LOG_DICT_ESCAPE       (0xDB)
+#define ESP_UTILS_LOG_DICT_ESCAPE_XOR   (0x20)
+#define ESP_UTILS_LOG_DICT_MAGIC        (0x4C4F4744)
+
+/**
+ * @brief Flags of a call-site descriptor
+ */
+#define ESP_UTILS_LOG_DICT_FLAG_RUNTIME_TAG     (1U << 0)   /*!< The tag is not known at compile time and is sent as
+                                                             *   the first string argument */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Call-site descriptor, one constant instance is generated for each log call and stays in the firmware.
+ *        The host decoder finds them in the ELF file by their symbol name (`esp_utils_log_dict_site`)
+ */
+typedef struct {
+    uint32_t magic;         /*!< Always `ESP_UTILS_LOG_DICT_MAGIC`, used to validate the descriptor */
+    uint16_t level;         /*!< Level of the message, see `ESP_UTILS_LOG_LEVEL_*` */
+    uint16_t flags;         /*!< See `ESP_UTILS_LOG_DICT_FLAG_*` */
+    uint32_t line;          /*!< Line of the call, 0 if unknown */
+    const char *tag;        /*!< Tag of the message, NULL if `ESP_UTILS_LOG_DICT_FLAG_RUNTIME_TAG` is set */
+    const char *file;       /*!< File of the call, NULL if unknown */
+    const char *func;       /*!< Function of the call, NULL if unknown */
+    const char *format;     /*!< Format string */
+} esp_utils_log_dict_site_t;
+
+/**
+ * @brief Function to output an encoded frame
+ *
+ * @param[in] user_ctx User context passed to `esp_utils_log_dict_set_output()`
+ * @param[in] data     Frame data
+ * @param[in] len      Length of `data`
+ */
+typedef void (*esp_utils_log_dict_output_func_t)(void *user_ctx, const uint8_t *data, size_t len);
+
+/**
+ * @brief Reference point of the call-site IDs
+ */
+extern const esp_utils_log_dict_site_t esp_utils_log_dict_anchor;
+
+/**
+ * @brief Set the function to output encoded frames, the default one writes them to `stdout`
+ *
+ * @note  It should be called before logging starts
+ *
+ * @param[in] func     Output function, NULL to restore the default one
+ * @param[in] user_ctx User context passed to `func`
+ */
+void esp_utils_log_dict_set_output(esp_utils_log_dict_output_func_t func, void *user_ctx);
+
+/**
+ * @brief Encode a message and output it
+ *
+ * @param[in] site   Call-site descriptor
+ * @param[in] format Same as `site->format`, only used to let the compiler check the arguments
+ * @param[in] ...    Arguments of the format string
+ */
+void esp_utils_log_dict_write(const esp_utils_log_dict_site_t *site, const char *format, ...)
+__attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Same as `esp_utils_log_dict_write()`, for call-sites with `ESP_UTILS_LOG_DICT_FLAG_RUNTIME_TAG`
+ */
+void esp_utils_log_dict_write_tag(const esp_utils_log_dict_site_t *site, const char *tag, const char *format, ...)
+__attribute__((format(printf, 3, 4)));
+
+/**
+ * @brief Same as `esp_utils_log_dict_write_tag()`, but with a `va_list`
+ */
+void esp_utils_log_dict_writev(const esp_utils_log_dict_site_t *site, const char *tag, const char *format, va_list args);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @brief Emit a message from a call-site whose tag and location are known at compile time
+ */
+#define ESP_UTILS_LOG_DICT_WRITE(level, TAG, format, ...) do {                                          \
+        static const esp_utils_log_dict_site_t esp_utils_log_dict_site = {                          \
+            ESP_UTILS_LOG_DICT_MAGIC, (level), 0, __LINE__, TAG, __FILE__, __func__, format           \
+        };                                                                                          \
+        esp_utils_log_dict_write(&esp_utils_log_dict_site, format, ##__VA_ARGS__);                   \
+    } while (0)
+
+/**
+ * @brief Emit a message with a runtime tag, the format string already contains the location if needed
+ */
+#define ESP_UTILS_LOG_DICT_WRITE_TAG(level, TAG, format, ...) do {                                      \
+        static const esp_utils_log_dict_site_t esp_utils_log_dict_site = {                          \
+            ESP_UTILS_LOG_DICT_MAGIC, (level), ESP_UTILS_LOG_DICT_FLAG_RUNTIME_TAG, 0, NULL, NULL, NULL, format \
+        };                                                                                          \
+        esp_utils_log_dict_write_tag(&esp_utils_log_dict_site, TAG, format, ##__VA_ARGS__);          \
+    } while (0)
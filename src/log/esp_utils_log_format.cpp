@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "esp_utils_log_format.hpp"
+
+namespace esp_utils {
+namespace log_format {
+namespace detail {
+
+namespace {
+
+constexpr size_t NUMBER_BUFFER_SIZE = 72;
+
+size_t formatPrefix(char *buffer, const Spec &spec, bool negative, unsigned base)
+{
+    size_t len = 0;
+
+    if (negative) {
+        buffer[len++] = '-';
+    } else if (spec.plus) {
+        buffer[len++] = '+';
+    }
+    if (spec.alternate && (base != 10)) {
+        buffer[len++] = '0';
+        if (base == 16) {
+            buffer[len++] = (spec.type == 'X') ? 'X' : 'x';
+        } else if (base == 2) {
+            buffer[len++] = 'b';
+        }
+    }
+
+    return len;
+}
+
+} // namespace
+
+void writeInteger(Writer &writer, const Spec &spec, uint64_t magnitude, bool negative)
+{
+    unsigned base = 10;
+    switch (spec.type) {
+    case 'x':
+    case 'X':
+        base = 16;
+        break;
+    case 'o':
+        base = 8;
+        break;
+    case 'b':
+        base = 2;
+        break;
+    default:
+        break;
+    }
+    const char *digits = (spec.type == 'X') ? "0123456789ABCDEF" : "0123456789abcdef";
+
+    // Digits are generated backwards at the end of the buffer, then the prefix is placed right before them
+    char buffer[NUMBER_BUFFER_SIZE];
+    size_t begin = sizeof(buffer);
+    do {
+        buffer[--begin] = digits[magnitude % base];
+        magnitude /= base;
+    } while (magnitude != 0);
+
+    char prefix[4];
+    size_t prefix_len = formatPrefix(prefix, spec, negative, base);
+    begin -= prefix_len;
+    memcpy(buffer + begin, prefix, prefix_len);
+
+    writer.putField(spec, buffer + begin, sizeof(buffer) - begin, prefix_len, '>');
+}
+
+void writeFloating(Writer &writer, const Spec &spec, double value)
+{
+    // Build the conversion from the spec, width and alignment are handled by the writer
+    char conversion[8];
+    size_t len = 0;
+    conversion[len++] = '%';
+    if (spec.plus) {
+        conversion[len++] = '+';
+    }
+    if (spec.alternate) {
+        conversion[len++] = '#';
+    }
+    conversion[len++] = '.';
+    conversion[len++] = '*';
+    conversion[len++] = (spec.type != 0) ? spec.type : 'g';
+    conversion[len] = '\0';
+
+    char buffer[NUMBER_BUFFER_SIZE];
+    int ret = snprintf(buffer, sizeof(buffer), conversion, (spec.precision >= 0) ? spec.precision : 6, value);
+    if (ret < 0) {
+        return;
+    }
+    size_t body_len = (static_cast<size_t>(ret) < sizeof(buffer)) ? ret : (sizeof(buffer) - 1);
+    size_t prefix_len = ((buffer[0] == '-') || (buffer[0] == '+')) ? 1 : 0;
+
+    writer.putField(spec, buffer, body_len, prefix_len, '>');
+}
+
+void writeString(Writer &writer, const Spec &spec, const char *str, size_t len)
+{
+    if ((spec.precision >= 0) && (len > static_cast<size_t>(spec.precision))) {
+        len = spec.precision;
+    }
+
+    writer.putField(spec, str, len, 0, '<');
+}
+
+void writePointer(Writer &writer, const Spec &spec, const void *ptr)
+{
+    Spec hex_spec = spec;
+    hex_spec.type = 'x';
+    hex_spec.alternate = true;
+
+    writeInteger(writer, hex_spec, reinterpret_cast<uintptr_t>(ptr), false);
+}
+
+} // namespace detail
+} // namespace log_format
+} // namespace esp_utils
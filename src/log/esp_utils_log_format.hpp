@@ -0,0 +1,533 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "esp_utils_log.h"
+
+/**
+ * `{}`-style formatting for C++, the format string is parsed and checked against the argument types at compile time.
+ *
+ * Placeholder syntax: `{[:[[fill]align][+][#][0][width][.precision][type]]}`, `{{` and `}}` are literal braces.
+ *  - align: '<' (left), '>' (right), '^' (center)
+ *  - type:  'd', 'x', 'X', 'o', 'b' (integers), 'c' (characters), 's' (strings, bools), 'p' (pointers),
+ *           'f', 'F', 'e', 'E', 'g', 'G' (floating point numbers)
+ *
+ * Supported arguments: integers, enums, bool, char, floating point numbers, C strings, `std::string`,
+ * `std::string_view` and pointers.
+ */
+
+namespace esp_utils {
+namespace log_format {
+namespace detail {
+
+enum class ArgKind : uint8_t {
+    Integer,
+    Char,
+    Bool,
+    Floating,
+    String,
+    Pointer,
+};
+
+template <typename T>
+struct DependentFalse: std::false_type {};
+
+template <typename T>
+constexpr ArgKind getArgKind()
+{
+    using U = std::remove_cv_t<std::remove_reference_t<T>>;
+
+    if constexpr (std::is_same_v<U, bool>) {
+        return ArgKind::Bool;
+    } else if constexpr (std::is_same_v<U, char>) {
+        return ArgKind::Char;
+    } else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>) {
+        return ArgKind::Integer;
+    } else if constexpr (std::is_floating_point_v<U>) {
+        return ArgKind::Floating;
+    } else if constexpr (std::is_array_v<U> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<U>>, char>) {
+        return ArgKind::String;
+    } else if constexpr (std::is_pointer_v<U> && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<U>>, char>) {
+        return ArgKind::String;
+    } else if constexpr (std::is_same_v<U, std::string> || std::is_same_v<U, std::string_view>) {
+        return ArgKind::String;
+    } else if constexpr (std::is_pointer_v<U> || std::is_null_pointer_v<U>) {
+        return ArgKind::Pointer;
+    } else {
+        static_assert(DependentFalse<U>::value, "Unsupported log argument type");
+        return ArgKind::Integer;
+    }
+}
+
+struct Spec {
+    char fill = ' ';
+    char align = 0;
+    bool plus = false;
+    bool alternate = false;
+    bool zero = false;
+    uint16_t width = 0;
+    int16_t precision = -1;
+    char type = 0;
+};
+
+struct Segment {
+    uint16_t literal_begin = 0;     // Literal text before the placeholder (or the end of the string)
+    uint16_t literal_len = 0;
+    bool literal_escaped = false;   // Literal contains "{{" or "}}"
+    Spec spec;
+};
+
+constexpr bool isDigit(char c)
+{
+    return (c >= '0') && (c <= '9');
+}
+
+constexpr bool isAlign(char c)
+{
+    return (c == '<') || (c == '>') || (c == '^');
+}
+
+/**
+ * Parse a placeholder, `pos` points after '{' and is moved after '}'
+ */
+constexpr bool parseSpec(const char *fmt, size_t &pos, Spec &spec)
+{
+    if (fmt[pos] == '}') {
+        pos++;
+        return true;
+    }
+    if (fmt[pos] != ':') {
+        return false;
+    }
+    pos++;
+
+    if ((fmt[pos] != '\0') && isAlign(fmt[pos + 1])) {
+        spec.fill = fmt[pos];
+        spec.align = fmt[pos + 1];
+        pos += 2;
+    } else if (isAlign(fmt[pos])) {
+        spec.align = fmt[pos++];
+    }
+    if (fmt[pos] == '+') {
+        spec.plus = true;
+        pos++;
+    }
+    if (fmt[pos] == '#') {
+        spec.alternate = true;
+        pos++;
+    }
+    if (fmt[pos] == '0') {
+        spec.zero = true;
+        pos++;
+    }
+    int width = 0;
+    while (isDigit(fmt[pos])) {
+        width = width * 10 + (fmt[pos++] - '0');
+        if (width > 255) {
+            return false;
+        }
+    }
+    spec.width = static_cast<uint16_t>(width);
+    if (fmt[pos] == '.') {
+        pos++;
+        if (!isDigit(fmt[pos])) {
+            return false;
+        }
+        int precision = 0;
+        while (isDigit(fmt[pos])) {
+            precision = precision * 10 + (fmt[pos++] - '0');
+            if (precision > 255) {
+                return false;
+            }
+        }
+        spec.precision = static_cast<int16_t>(precision);
+    }
+    if ((fmt[pos] != '}') && (fmt[pos] != '\0')) {
+        spec.type = fmt[pos++];
+    }
+    if (fmt[pos] != '}') {
+        return false;
+    }
+    pos++;
+
+    return true;
+}
+
+/**
+ * Walk the format string, call `on_segment(segment)` for each placeholder and once more for the trailing literal.
+ * Return false if the format string is invalid
+ */
+template <typename Callback>
+constexpr bool walkFormat(const char *fmt, Callback &&on_segment)
+{
+    size_t pos = 0;
+    Segment segment{};
+
+    while (true) {
+        char c = fmt[pos];
+        if (c == '\0') {
+            segment.literal_len = static_cast<uint16_t>(pos - segment.literal_begin);
+            on_segment(segment, false);
+            return true;
+        }
+        if (((c == '{') && (fmt[pos + 1] == '{')) || ((c == '}') && (fmt[pos + 1] == '}'))) {
+            segment.literal_escaped = true;
+            pos += 2;
+            continue;
+        }
+        if (c == '}') {
+            return false;
+        }
+        if (c == '{') {
+            segment.literal_len = static_cast<uint16_t>(pos - segment.literal_begin);
+            pos++;
+            if (!parseSpec(fmt, pos, segment.spec)) {
+                return false;
+            }
+            on_segment(segment, true);
+            segment = Segment{};
+            segment.literal_begin = static_cast<uint16_t>(pos);
+            continue;
+        }
+        pos++;
+    }
+}
+
+struct Counter {
+    int *count;
+
+    constexpr void operator()(const Segment &, bool is_placeholder) const
+    {
+        if (is_placeholder) {
+            (*count)++;
+        }
+    }
+};
+
+/**
+ * Return the number of placeholders, or -1 if the format string is invalid
+ */
+constexpr int countPlaceholders(const char *fmt)
+{
+    int count = 0;
+
+    return walkFormat(fmt, Counter{&count}) ? count : -1;
+}
+
+template <size_t N>
+struct Collector {
+    std::array<Segment, N + 1> *segments;
+    size_t *index;
+
+    constexpr void operator()(const Segment &segment, bool) const
+    {
+        if (*index < segments->size()) {
+            (*segments)[(*index)++] = segment;
+        }
+    }
+};
+
+template <size_t N>
+constexpr std::array<Segment, N + 1> parseFormat(const char *fmt)
+{
+    std::array<Segment, N + 1> segments{};
+    size_t index = 0;
+
+    walkFormat(fmt, Collector<N> {&segments, &index});
+
+    return segments;
+}
+
+constexpr bool isSpecCompatible(const Spec &spec, ArgKind kind)
+{
+    const bool is_number = (kind == ArgKind::Integer) || (kind == ArgKind::Floating);
+
+    if ((spec.plus || spec.zero) && !is_number) {
+        return false;
+    }
+    if ((spec.precision >= 0) && (kind != ArgKind::Floating) && (kind != ArgKind::String)) {
+        return false;
+    }
+
+    switch (spec.type) {
+    case 0:
+        return true;
+    case 'd':
+    case 'x':
+    case 'X':
+    case 'o':
+    case 'b':
+        return (kind == ArgKind::Integer) || (kind == ArgKind::Char) || (kind == ArgKind::Bool);
+    case 'c':
+        return (kind == ArgKind::Integer) || (kind == ArgKind::Char);
+    case 's':
+        return (kind == ArgKind::String) || (kind == ArgKind::Bool);
+    case 'p':
+        return (kind == ArgKind::Pointer) || (kind == ArgKind::String);
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+        return kind == ArgKind::Floating;
+    default:
+        return false;
+    }
+}
+
+template <size_t N>
+constexpr bool checkSpecs(const std::array<Segment, N + 1> &segments, const std::array<ArgKind, N> &kinds)
+{
+    for (size_t i = 0; i < N; i++) {
+        if (!isSpecCompatible(segments[i].spec, kinds[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Bounded writer into a caller-provided buffer, the output is truncated when the buffer is full
+ */
+class Writer {
+public:
+    Writer(char *buffer, size_t size)
+        : _buffer(buffer)
+        , _capacity((size > 0) ? (size - 1) : 0)
+    {
+    }
+
+    void put(char c)
+    {
+        if (_len < _capacity) {
+            _buffer[_len++] = c;
+        }
+    }
+
+    void put(const char *data, size_t len)
+    {
+        size_t room = _capacity - _len;
+        if (len > room) {
+            len = room;
+        }
+        memcpy(_buffer + _len, data, len);
+        _len += len;
+    }
+
+    void fill(char c, size_t count)
+    {
+        while (count-- > 0) {
+            put(c);
+        }
+    }
+
+    void putLiteral(const char *fmt, const Segment &segment)
+    {
+        const char *literal = fmt + segment.literal_begin;
+        if (!segment.literal_escaped) {
+            put(literal, segment.literal_len);
+            return;
+        }
+        for (size_t i = 0; i < segment.literal_len; i++) {
+            put(literal[i]);
+            if (((literal[i] == '{') || (literal[i] == '}')) && (i + 1 < segment.literal_len)) {
+                i++;
+            }
+        }
+    }
+
+    /**
+     * Write `body` with the width and alignment of `spec`, `prefix_len` leading characters (sign, "0x") are kept
+     * before the zero padding
+     */
+    void putField(const Spec &spec, const char *body, size_t len, size_t prefix_len, char default_align)
+    {
+        size_t padding = (spec.width > len) ? (spec.width - len) : 0;
+        if (padding == 0) {
+            put(body, len);
+            return;
+        }
+        if (spec.zero && (spec.align == 0)) {
+            put(body, prefix_len);
+            fill('0', padding);
+            put(body + prefix_len, len - prefix_len);
+            return;
+        }
+
+        char align = (spec.align != 0) ? spec.align : default_align;
+        size_t before = (align == '>') ? padding : ((align == '^') ? (padding / 2) : 0);
+        fill(spec.fill, before);
+        put(body, len);
+        fill(spec.fill, padding - before);
+    }
+
+    size_t finish()
+    {
+        _buffer[_len] = '\0';
+        return _len;
+    }
+
+private:
+    char *_buffer = nullptr;
+    size_t _capacity = 0;
+    size_t _len = 0;
+};
+
+void writeInteger(Writer &writer, const Spec &spec, uint64_t magnitude, bool negative);
+void writeFloating(Writer &writer, const Spec &spec, double value);
+void writeString(Writer &writer, const Spec &spec, const char *str, size_t len);
+void writePointer(Writer &writer, const Spec &spec, const void *ptr);
+
+template <typename T>
+void writeArg(Writer &writer, const Spec &spec, const T &value)
+{
+    using U = std::remove_cv_t<std::remove_reference_t<T>>;
+    constexpr ArgKind kind = getArgKind<T>();
+
+    if constexpr (kind == ArgKind::Bool) {
+        if ((spec.type == 0) || (spec.type == 's')) {
+            writeString(writer, spec, value ? "true" : "false", value ? 4 : 5);
+        } else {
+            writeInteger(writer, spec, value ? 1 : 0, false);
+        }
+    } else if constexpr (kind == ArgKind::Char) {
+        if ((spec.type == 0) || (spec.type == 'c')) {
+            writeString(writer, spec, &value, 1);
+        } else {
+            writeInteger(writer, spec, static_cast<unsigned char>(value), false);
+        }
+    } else if constexpr (kind == ArgKind::Integer) {
+        using I = typename std::conditional_t<std::is_enum_v<U>, std::underlying_type<U>, std::common_type<U>>::type;
+        I number = static_cast<I>(value);
+        if (spec.type == 'c') {
+            char c = static_cast<char>(number);
+            writeString(writer, spec, &c, 1);
+        } else if constexpr (std::is_signed_v<I>) {
+            bool negative = number < 0;
+            uint64_t magnitude = negative ? (0 - static_cast<uint64_t>(number)) : static_cast<uint64_t>(number);
+            writeInteger(writer, spec, magnitude, negative);
+        } else {
+            writeInteger(writer, spec, static_cast<uint64_t>(number), false);
+        }
+    } else if constexpr (kind == ArgKind::Floating) {
+        writeFloating(writer, spec, static_cast<double>(value));
+    } else if constexpr (kind == ArgKind::String) {
+        if constexpr (std::is_same_v<U, std::string> || std::is_same_v<U, std::string_view>) {
+            writeString(writer, spec, value.data(), value.size());
+        } else if (spec.type == 'p') {
+            writePointer(writer, spec, value);
+        } else if constexpr (std::is_array_v<U>) {
+            writeString(writer, spec, value, strnlen(value, sizeof(U)));
+        } else {
+            writeString(writer, spec, (value != nullptr) ? value : "(null)", (value != nullptr) ? strlen(value) : 6);
+        }
+    } else {
+        writePointer(writer, spec, static_cast<const void *>(value));
+    }
+}
+
+template <size_t N, typename... Args>
+size_t formatSegments(
+    char *buffer, size_t size, const char *fmt, const std::array<Segment, N + 1> &segments, const Args &... args
+)
+{
+    Writer writer(buffer, size);
+    size_t index = 0;
+
+    ((writer.putLiteral(fmt, segments[index]), writeArg(writer, segments[index].spec, args), index++), ...);
+    writer.putLiteral(fmt, segments[N]);
+
+    return writer.finish();
+}
+
+} // namespace detail
+
+/**
+ * @brief Format into a buffer, the format string is given by `ESP_UTILS_LOG_FMT_STRING()` and checked at compile
+ *        time. The output is truncated if the buffer is too small
+ *
+ * @param[out] buffer Output buffer, always null-terminated
+ * @param[in]  size   Size of `buffer`, must be greater than 0
+ * @param[in]  ...    Format string and arguments
+ *
+ * @return Length of the output (excluding the terminator)
+ */
+template <typename FormatString, typename... Args>
+size_t formatTo(char *buffer, size_t size, FormatString, const Args &... args)
+{
+    constexpr const char *fmt = FormatString::value();
+    constexpr int count = detail::countPlaceholders(fmt);
+    static_assert(count >= 0, "Invalid log format string");
+    static_assert(count == static_cast<int>(sizeof...(Args)), "Log format string and arguments count mismatch");
+
+    constexpr size_t N = sizeof...(Args);
+    static constexpr auto segments = detail::parseFormat<N>(fmt);
+    static_assert(
+        detail::checkSpecs<N>(segments, std::array<detail::ArgKind, N> {detail::getArgKind<Args>()...}),
+        "Log format spec doesn't match the argument type"
+    );
+
+    return detail::formatSegments<N>(buffer, size, fmt, segments, args...);
+}
+
+} // namespace log_format
+} // namespace esp_utils
+
+/**
+ * @brief Turn a string literal into a type, so that it can be parsed at compile time
+ */
+#define ESP_UTILS_LOG_FMT_STRING(str)                                                       \
+    [] {                                                                                    \
+        struct _EspUtilsLogFmtString {                                                      \
+            static constexpr const char *value()                                            \
+            {                                                                               \
+                return str;                                                                 \
+            }                                                                               \
+        };                                                                                  \
+        return _EspUtilsLogFmtString{};                                                     \
+    }()
+
+#if ESP_UTILS_CONF_LOG_ENABLE_SINK
+#   define ESP_UTILS_LOG_FMT_LEVEL_ENABLED(level)   esp_utils_log_sink_is_enabled(level)
+#else
+#   define ESP_UTILS_LOG_FMT_LEVEL_ENABLED(level)   (true)
+#endif
+
+/**
+ * @brief The format string is always checked, even if the level is disabled
+ */
+#define ESP_UTILS_LOG_FMT_LEVEL_LOCAL(level, impl, format, ...) do {                                            \
+        if ((level >= ESP_UTILS_LOG_CURRENT_LEVEL) && ESP_UTILS_LOG_FMT_LEVEL_ENABLED(level)) {                 \
+            char _esp_utils_log_fmt_buffer_[ESP_UTILS_CONF_LOG_FMT_BUFFER_SIZE];                                \
+            esp_utils::log_format::formatTo(                                                                    \
+                _esp_utils_log_fmt_buffer_, sizeof(_esp_utils_log_fmt_buffer_), ESP_UTILS_LOG_FMT_STRING(format), \
+                ##__VA_ARGS__                                                                                   \
+            );                                                                                                  \
+            impl(ESP_UTILS_LOG_TAG, "%s", _esp_utils_log_fmt_buffer_);                                          \
+        }                                                                                                       \
+    } while (0)
+
+/**
+ * Macros to log with a `{}`-style format string, e.g. `ESP_UTILS_LOGI_FMT("Value: {}, name: {:>8}", 1, "test")`
+ */
+#define ESP_UTILS_LOGD_FMT(format, ...) \
+    ESP_UTILS_LOG_FMT_LEVEL_LOCAL(ESP_UTILS_LOG_LEVEL_DEBUG, ESP_UTILS_LOGD_IMPL, format, ##__VA_ARGS__)
+#define ESP_UTILS_LOGI_FMT(format, ...) \
+    ESP_UTILS_LOG_FMT_LEVEL_LOCAL(ESP_UTILS_LOG_LEVEL_INFO, ESP_UTILS_LOGI_IMPL, format, ##__VA_ARGS__)
+#define ESP_UTILS_LOGW_FMT(format, ...) \
+    ESP_UTILS_LOG_FMT_LEVEL_LOCAL(ESP_UTILS_LOG_LEVEL_WARNING, ESP_UTILS_LOGW_IMPL, format, ##__VA_ARGS__)
+#define ESP_UTILS_LOGE_FMT(format, ...) \
+    ESP_UTILS_LOG_FMT_LEVEL_LOCAL(ESP_UTILS_LOG_LEVEL_ERROR, ESP_UTILS_LOGE_IMPL, format, ##__VA_ARGS__)
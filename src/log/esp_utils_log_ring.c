@@ -0,0 +1,161 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+#include "esp_utils_log_ring.h"
+
+#define RING_MAGIC  (0x4C4F4752)    /* "LOGR" */
+
+static bool is_valid_param(const esp_utils_log_ring_t *ring, const char *buffer, size_t size)
+{
+    return (ring != NULL) && (buffer != NULL) && (size > 0) && ((size & (size - 1)) == 0) && (size <= UINT32_MAX / 2);
+}
+
+static uint32_t get_content(const esp_utils_log_ring_t *ring, uint32_t *start)
+{
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    // A concurrent writer may have reserved space but not set the flag yet
+    bool wrapped = __atomic_load_n(&ring->wrapped, __ATOMIC_RELAXED) || (head > ring->size);
+    uint32_t avail = wrapped ? ring->size : head;
+    uint32_t pos = head - avail;
+
+    if (wrapped) {
+        // The oldest line has been partially overwritten, skip it
+        uint32_t skipped = 0;
+        while ((skipped < avail) && (ring->buffer[(pos + skipped) & (ring->size - 1)] != '\n')) {
+            skipped++;
+        }
+        if (skipped < avail) {
+            skipped++;
+        }
+        pos += skipped;
+        avail -= skipped;
+    }
+    *start = pos;
+
+    return avail;
+}
+
+bool esp_utils_log_ring_init(esp_utils_log_ring_t *ring, char *buffer, size_t size)
+{
+    if (!is_valid_param(ring, buffer, size)) {
+        return false;
+    }
+
+    ring->buffer = buffer;
+    ring->size = (uint32_t)size;
+    __atomic_store_n(&ring->head, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->wrapped, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->magic, RING_MAGIC, __ATOMIC_RELEASE);
+
+    return true;
+}
+
+bool esp_utils_log_ring_restore(esp_utils_log_ring_t *ring, char *buffer, size_t size)
+{
+    if (!is_valid_param(ring, buffer, size)) {
+        return false;
+    }
+
+    if ((ring->magic == RING_MAGIC) && (ring->buffer == buffer) && (ring->size == size) &&
+            (ring->wrapped || (ring->head <= size))) {
+        return true;
+    }
+    esp_utils_log_ring_init(ring, buffer, size);
+
+    return false;
+}
+
+void esp_utils_log_ring_write(esp_utils_log_ring_t *ring, const char *data, size_t len)
+{
+    if ((ring == NULL) || (data == NULL) || (len == 0) ||
+            (__atomic_load_n(&ring->magic, __ATOMIC_ACQUIRE) != RING_MAGIC)) {
+        return;
+    }
+
+    // Reserve space first, so concurrent writers never share bytes unless the ring is lapped
+    uint32_t start = __atomic_fetch_add(&ring->head, (uint32_t)len, __ATOMIC_RELAXED);
+    uint32_t mask = ring->size - 1;
+    size_t skip = (len > ring->size) ? (len - ring->size) : 0;
+    uint32_t pos = start + (uint32_t)skip;
+    size_t remain = len - skip;
+
+    while (remain > 0) {
+        uint32_t offset = pos & mask;
+        size_t chunk = ring->size - offset;
+        if (chunk > remain) {
+            chunk = remain;
+        }
+        memcpy(ring->buffer + offset, data + (len - remain), chunk);
+        pos += (uint32_t)chunk;
+        remain -= chunk;
+    }
+
+    if (((uint64_t)start + len) >= ring->size) {
+        __atomic_store_n(&ring->wrapped, 1, __ATOMIC_RELAXED);
+    }
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+size_t esp_utils_log_ring_read(const esp_utils_log_ring_t *ring, char *out, size_t out_size)
+{
+    if ((ring == NULL) || (out == NULL) || (out_size == 0)) {
+        return 0;
+    }
+    out[0] = '\0';
+    if (ring->magic != RING_MAGIC) {
+        return 0;
+    }
+
+    uint32_t start = 0;
+    uint32_t avail = get_content(ring, &start);
+    if (avail > out_size - 1) {
+        start += avail - (uint32_t)(out_size - 1);
+        avail = (uint32_t)(out_size - 1);
+    }
+    for (uint32_t i = 0; i < avail; i++) {
+        out[i] = ring->buffer[(start + i) & (ring->size - 1)];
+    }
+    out[avail] = '\0';
+
+    return avail;
+}
+
+size_t esp_utils_log_ring_dump(const esp_utils_log_ring_t *ring, FILE *stream)
+{
+    if ((ring == NULL) || (stream == NULL) || (ring->magic != RING_MAGIC)) {
+        return 0;
+    }
+
+    uint32_t start = 0;
+    uint32_t avail = get_content(ring, &start);
+    uint32_t offset = start & (ring->size - 1);
+    size_t first = ring->size - offset;
+    if (first > avail) {
+        first = avail;
+    }
+    size_t written = fwrite(ring->buffer + offset, 1, first, stream);
+    written += fwrite(ring->buffer, 1, avail - first, stream);
+    fflush(stream);
+
+    return written;
+}
+
+void esp_utils_log_ring_clear(esp_utils_log_ring_t *ring)
+{
+    if ((ring == NULL) || (ring->magic != RING_MAGIC)) {
+        return;
+    }
+
+    __atomic_store_n(&ring->wrapped, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&ring->head, 0, __ATOMIC_RELEASE);
+}
+
+void esp_utils_log_ring_sink_write(void *user_ctx, int level, const char *tag, const char *msg, size_t len)
+{
+    (void)level;
+    (void)tag;
+    esp_utils_log_ring_write((esp_utils_log_ring_t *)user_ctx, msg, len);
+}
@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Lock-free RAM ring buffer which keeps the most recent log output, it can be used as a log sink and read
+ *        after a crash.
+ *
+ * @note  To keep the content across a software reset, place both the ring object and its buffer in a memory region
+ *        which is not initialized at startup (e.g. `__NOINIT_ATTR` or `RTC_NOINIT_ATTR` on ESP-IDF), and call
+ *        `esp_utils_log_ring_restore()` instead of `esp_utils_log_ring_init()`.
+ */
+typedef struct {
+    uint32_t magic;     /*!< Used to validate the ring after a reset */
+    uint32_t size;      /*!< Size of `buffer`, must be a power of two */
+    uint32_t head;      /*!< Total number of bytes written since initialization (wraps around) */
+    uint32_t wrapped;   /*!< Set once the ring has been filled at least once */
+    char *buffer;       /*!< Storage of the ring */
+} esp_utils_log_ring_t;
+
+/**
+ * @brief Initialize a ring and discard its content
+ *
+ * @param[in] ring   Ring to initialize
+ * @param[in] buffer Storage of the ring
+ * @param[in] size   Size of `buffer`, must be a power of two
+ *
+ * @return true if success, false if the parameters are invalid
+ */
+bool esp_utils_log_ring_init(esp_utils_log_ring_t *ring, char *buffer, size_t size);
+
+/**
+ * @brief Initialize a ring, but keep its content if it is still valid (e.g. after a software reset)
+ *
+ * @param[in] ring   Ring to initialize
+ * @param[in] buffer Storage of the ring
+ * @param[in] size   Size of `buffer`, must be a power of two
+ *
+ * @return true if the previous content is kept, false if the ring has been reinitialized or the parameters are invalid
+ */
+bool esp_utils_log_ring_restore(esp_utils_log_ring_t *ring, char *buffer, size_t size);
+
+/**
+ * @brief Append data to a ring, it is lock-free and allocation-free, so it can be called from any context
+ *
+ * @param[in] ring Ring to write
+ * @param[in] data Data to append
+ * @param[in] len  Length of `data`
+ */
+void esp_utils_log_ring_write(esp_utils_log_ring_t *ring, const char *data, size_t len);
+
+/**
+ * @brief Copy the content of a ring (oldest first). If the ring has wrapped around, the first partial line is skipped
+ *
+ * @param[in]  ring     Ring to read
+ * @param[out] out      Output buffer, it is null-terminated if `out_size` is not zero
+ * @param[in]  out_size Size of `out`, the most recent content is kept if it is too small
+ *
+ * @return Number of bytes copied (without the null terminator)
+ */
+size_t esp_utils_log_ring_read(const esp_utils_log_ring_t *ring, char *out, size_t out_size);
+
+/**
+ * @brief Write the content of a ring (oldest first) to a stream, without any extra buffer
+ *
+ * @param[in] ring   Ring to dump
+ * @param[in] stream Output stream, e.g. `stdout`
+ *
+ * @return Number of bytes written
+ */
+size_t esp_utils_log_ring_dump(const esp_utils_log_ring_t *ring, FILE *stream);
+
+/**
+ * @brief Discard the content of a ring
+ *
+ * @param[in] ring Ring to clear
+ */
+void esp_utils_log_ring_clear(esp_utils_log_ring_t *ring);
+
+/**
+ * @brief Sink write function which appends messages to a ring (passed as `user_ctx`), see `esp_utils_log_sink_t`
+ */
+void esp_utils_log_ring_sink_write(void *user_ctx, int level, const char *tag, const char *msg, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,236 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "esp_utils_conf_internal.h"
+#if ESP_UTILS_CONF_LOG_ENABLE_SINK
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#if ESP_UTILS_CONF_LOG_IMPL_TYPE == ESP_UTILS_LOG_IMPL_ESP
+#   include "esp_log.h"
+#endif
+#if defined(ESP_PLATFORM)
+#   include "freertos/FreeRTOS.h"
+#   include "freertos/task.h"
+#elif defined(__unix__) || defined(__APPLE__)
+#   include <sched.h>
+#endif
+#include "esp_utils_log_sink.h"
+
+#if ESP_UTILS_CONF_LOG_IMPL_TYPE == ESP_UTILS_LOG_IMPL_ESP
+static void console_log(esp_log_level_t level, const char *tag, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    esp_log_writev(level, tag, format, args);
+    va_end(args);
+}
+
+#if defined(CONFIG_LOG_TIMESTAMP_SOURCE_SYSTEM) && CONFIG_LOG_TIMESTAMP_SOURCE_SYSTEM
+#   define CONSOLE_FORMAT(letter, color)    color #letter " (%s) %s: %.*s" LOG_RESET_COLOR "\n"
+#   define CONSOLE_TIMESTAMP()              esp_log_system_timestamp()
+#else
+#   define CONSOLE_FORMAT(letter, color)    color #letter " (%" PRIu32 ") %s: %.*s" LOG_RESET_COLOR "\n"
+#   define CONSOLE_TIMESTAMP()              esp_log_timestamp()
+#endif
+
+/**
+ * Output the message in the same format as `ESP_LOGx()` (level letter, timestamp, tag and color), the "[L][tag]"
+ * prefix and the trailing '\n' added by the dispatcher are replaced by the ESP ones
+ */
+static void console_write_esp(int level, const char *tag, const char *msg, size_t len)
+{
+    static const esp_log_level_t esp_levels[] = { ESP_LOG_DEBUG, ESP_LOG_INFO, ESP_LOG_WARN, ESP_LOG_ERROR };
+    static const char *const formats[] = {
+        CONSOLE_FORMAT(D, LOG_COLOR_D), CONSOLE_FORMAT(I, LOG_COLOR_I),
+        CONSOLE_FORMAT(W, LOG_COLOR_W), CONSOLE_FORMAT(E, LOG_COLOR_E),
+    };
+
+    if (tag == NULL) {
+        tag = "";
+    }
+    // Skip "[L][tag]" and the trailing '\n'
+    size_t prefix_len = 4 + strlen(tag);
+    if (prefix_len > len - 1) {
+        prefix_len = len - 1;
+    }
+    console_log(
+        esp_levels[level], tag, formats[level], CONSOLE_TIMESTAMP(), tag, (int)(len - 1 - prefix_len), msg + prefix_len
+    );
+}
+#endif // ESP_UTILS_CONF_LOG_IMPL_TYPE
+
+static void console_write(void *user_ctx, int level, const char *tag, const char *msg, size_t len)
+{
+    (void)user_ctx;
+#if ESP_UTILS_CONF_LOG_IMPL_TYPE == ESP_UTILS_LOG_IMPL_ESP
+    console_write_esp(level, tag, msg, len);
+#else
+    (void)level;
+    (void)tag;
+    fwrite(msg, 1, len, stdout);
+#endif
+}
+
+esp_utils_log_sink_t esp_utils_log_sink_console = ESP_UTILS_LOG_SINK_INIT(
+            console_write, NULL, ESP_UTILS_LOG_LEVEL_MASK_ALL
+        );
+uint32_t esp_utils_log_sink_active_mask = ESP_UTILS_LOG_LEVEL_MASK_ALL;
+
+static esp_utils_log_sink_t *sinks[ESP_UTILS_CONF_LOG_SINK_MAX_NUM] = { &esp_utils_log_sink_console };
+// Number of dispatchers which may be calling the sink of each slot, used by the unregistering grace period
+static uint32_t sink_users[ESP_UTILS_CONF_LOG_SINK_MAX_NUM];
+
+static uint32_t compute_active_mask(void)
+{
+    uint32_t mask = 0;
+
+    for (int i = 0; i < ESP_UTILS_CONF_LOG_SINK_MAX_NUM; i++) {
+        esp_utils_log_sink_t *sink = __atomic_load_n(&sinks[i], __ATOMIC_ACQUIRE);
+        if (sink != NULL) {
+            mask |= __atomic_load_n(&sink->level_mask, __ATOMIC_RELAXED);
+        }
+    }
+
+    return mask;
+}
+
+static void wait_sink_idle(int slot)
+{
+    // The counter is incremented before the slot is loaded (both sequentially consistent), so once the slot is cleared
+    // and the counter reaches zero, no dispatcher can still call the removed sink
+    while (__atomic_load_n(&sink_users[slot], __ATOMIC_SEQ_CST) != 0) {
+#if defined(ESP_PLATFORM)
+        // Sleep instead of yielding, the dispatcher may run in a lower priority task
+        if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+            vTaskDelay(1);
+        }
+#elif defined(__unix__) || defined(__APPLE__)
+        sched_yield();
+#endif
+    }
+}
+
+static void update_active_mask(void)
+{
+    // No lock here: every writer validates the mask after storing it, so the last one always leaves a correct value
+    uint32_t mask = 0;
+    do {
+        mask = compute_active_mask();
+        __atomic_store_n(&esp_utils_log_sink_active_mask, mask, __ATOMIC_RELAXED);
+    } while (mask != compute_active_mask());
+}
+
+bool esp_utils_log_sink_register(esp_utils_log_sink_t *sink)
+{
+    if ((sink == NULL) || (sink->write == NULL)) {
+        return false;
+    }
+
+    for (int i = 0; i < ESP_UTILS_CONF_LOG_SINK_MAX_NUM; i++) {
+        if (__atomic_load_n(&sinks[i], __ATOMIC_ACQUIRE) == sink) {
+            return true;
+        }
+    }
+
+    for (int i = 0; i < ESP_UTILS_CONF_LOG_SINK_MAX_NUM; i++) {
+        esp_utils_log_sink_t *expected = NULL;
+        if (__atomic_compare_exchange_n(&sinks[i], &expected, sink, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            update_active_mask();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool esp_utils_log_sink_unregister(esp_utils_log_sink_t *sink)
+{
+    if (sink == NULL) {
+        return false;
+    }
+
+    for (int i = 0; i < ESP_UTILS_CONF_LOG_SINK_MAX_NUM; i++) {
+        esp_utils_log_sink_t *expected = sink;
+        if (__atomic_compare_exchange_n(&sinks[i], &expected, NULL, false, __ATOMIC_SEQ_CST, __ATOMIC_ACQUIRE)) {
+            update_active_mask();
+            wait_sink_idle(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void esp_utils_log_sink_set_level_mask(esp_utils_log_sink_t *sink, uint32_t mask)
+{
+    if (sink == NULL) {
+        return;
+    }
+
+    __atomic_store_n(&sink->level_mask, mask & ESP_UTILS_LOG_LEVEL_MASK_ALL, __ATOMIC_RELAXED);
+    update_active_mask();
+}
+
+void esp_utils_log_sink_dispatchv(int level, const char *tag, const char *format, va_list args)
+{
+    static const char level_chars[] = { 'D', 'I', 'W', 'E' };
+
+    if ((level < ESP_UTILS_LOG_LEVEL_DEBUG) || (level >= ESP_UTILS_LOG_LEVEL_NONE) ||
+            !esp_utils_log_sink_is_enabled(level)) {
+        return;
+    }
+
+    // Format once, keep room for the trailing '\n' and '\0'
+    char buffer[ESP_UTILS_CONF_LOG_SINK_BUFFER_SIZE];
+    const int max_len = (int)sizeof(buffer) - 2;
+    int len = snprintf(buffer, sizeof(buffer), "[%c][%s]", level_chars[level], (tag != NULL) ? tag : "");
+    if (len < 0) {
+        return;
+    }
+    if (len < max_len) {
+        int ret = vsnprintf(buffer + len, sizeof(buffer) - len, format, args);
+        if (ret > 0) {
+            len += ret;
+        }
+    }
+    if (len > max_len) {
+        len = max_len;
+    }
+    buffer[len++] = '\n';
+    buffer[len] = '\0';
+
+    uint32_t level_mask = ESP_UTILS_LOG_LEVEL_MASK(level);
+    for (int i = 0; i < ESP_UTILS_CONF_LOG_SINK_MAX_NUM; i++) {
+        if (__atomic_load_n(&sinks[i], __ATOMIC_RELAXED) == NULL) {
+            continue;
+        }
+        __atomic_add_fetch(&sink_users[i], 1, __ATOMIC_SEQ_CST);
+        esp_utils_log_sink_t *sink = __atomic_load_n(&sinks[i], __ATOMIC_SEQ_CST);
+        if ((sink != NULL) && (__atomic_load_n(&sink->level_mask, __ATOMIC_RELAXED) & level_mask)) {
+            sink->write(sink->user_ctx, level, tag, buffer, (size_t)len);
+        }
+        __atomic_sub_fetch(&sink_users[i], 1, __ATOMIC_RELEASE);
+    }
+}
+
+void esp_utils_log_sink_dispatch(int level, const char *tag, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    esp_utils_log_sink_dispatchv(level, tag, format, args);
+    va_end(args);
+}
+
+void esp_utils_log_sink_stream_write(void *user_ctx, int level, const char *tag, const char *msg, size_t len)
+{
+    (void)level;
+    (void)tag;
+    if (user_ctx != NULL) {
+        fwrite(msg, 1, len, (FILE *)user_ctx);
+    }
+}
+
+#endif // ESP_UTILS_CONF_LOG_ENABLE_SINK
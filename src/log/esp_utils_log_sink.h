@@ -0,0 +1,140 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "esp_utils_conf_internal.h"
+
+/**
+ * @brief Macros to build the level mask of a sink
+ */
+#define ESP_UTILS_LOG_LEVEL_MASK(level)         (1U << (level))
+#define ESP_UTILS_LOG_LEVEL_MASK_ALL            (ESP_UTILS_LOG_LEVEL_MASK(ESP_UTILS_LOG_LEVEL_NONE) - 1)
+#define ESP_UTILS_LOG_LEVEL_MASK_FROM(level)    (ESP_UTILS_LOG_LEVEL_MASK_ALL & ~(ESP_UTILS_LOG_LEVEL_MASK(level) - 1))
+
+/**
+ * @brief Initializer of a sink
+ *
+ * @param write_func Function to output the formatted message, see `esp_utils_log_sink_write_func_t`
+ * @param ctx        User context passed to `write_func`
+ * @param mask       Levels accepted by the sink, see `ESP_UTILS_LOG_LEVEL_MASK()`
+ */
+#define ESP_UTILS_LOG_SINK_INIT(write_func, ctx, mask)  { .write = (write_func), .user_ctx = (ctx), .level_mask = (mask) }
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Function to output a formatted message
+ *
+ * @param[in] user_ctx User context of the sink
+ * @param[in] level    Level of the message, see `ESP_UTILS_LOG_LEVEL_*`
+ * @param[in] tag      Tag of the message
+ * @param[in] msg      Formatted message (including the level and tag prefix and the trailing '\n'), not null-terminated
+ * @param[in] len      Length of `msg`
+ */
+typedef void (*esp_utils_log_sink_write_func_t)(void *user_ctx, int level, const char *tag, const char *msg, size_t len);
+
+/**
+ * @brief Log sink, the object should stay valid while it is registered
+ */
+typedef struct {
+    esp_utils_log_sink_write_func_t write;  /*!< Function to output the formatted message */
+    void *user_ctx;                         /*!< User context passed to `write` */
+    uint32_t level_mask;                    /*!< Levels accepted by the sink, see `ESP_UTILS_LOG_LEVEL_MASK()` */
+} esp_utils_log_sink_t;
+
+/**
+ * @brief Default console sink (`printf` or `esp_log_writev()`, depending on `ESP_UTILS_CONF_LOG_IMPL_TYPE`), it is
+ *        registered at startup and accepts all levels
+ */
+extern esp_utils_log_sink_t esp_utils_log_sink_console;
+
+/**
+ * @brief Levels accepted by at least one registered sink, used to skip formatting when no sink needs the message
+ *
+ * @note  Do not modify it directly, it is updated when sinks are registered, unregistered or their masks changed
+ */
+extern uint32_t esp_utils_log_sink_active_mask;
+
+/**
+ * @brief Register a sink
+ *
+ * @param[in] sink Sink to register
+ *
+ * @return true if success (or already registered), false if the sink is invalid or there is no free slot
+ */
+bool esp_utils_log_sink_register(esp_utils_log_sink_t *sink);
+
+/**
+ * @brief Unregister a sink, it waits until no dispatcher is calling the sink, so the sink can be freed afterwards
+ *
+ * @note  Don't call it from the write function of a sink
+ *
+ * @param[in] sink Sink to unregister
+ *
+ * @return true if success, false if the sink is not registered
+ */
+bool esp_utils_log_sink_unregister(esp_utils_log_sink_t *sink);
+
+/**
+ * @brief Change the level mask of a sink, it can be called whether the sink is registered or not
+ *
+ * @param[in] sink Sink to modify
+ * @param[in] mask New level mask, see `ESP_UTILS_LOG_LEVEL_MASK()`
+ */
+void esp_utils_log_sink_set_level_mask(esp_utils_log_sink_t *sink, uint32_t mask);
+
+/**
+ * @brief Format a message once and dispatch it to all registered sinks which accept the level
+ *
+ * @param[in] level  Level of the message, see `ESP_UTILS_LOG_LEVEL_*`
+ * @param[in] tag    Tag of the message
+ * @param[in] format Format string
+ * @param[in] ...    Arguments of the format string
+ */
+void esp_utils_log_sink_dispatch(int level, const char *tag, const char *format, ...)
+__attribute__((format(printf, 3, 4)));
+
+/**
+ * @brief Same as `esp_utils_log_sink_dispatch()`, but with a `va_list`
+ */
+void esp_utils_log_sink_dispatchv(int level, const char *tag, const char *format, va_list args);
+
+/**
+ * @brief Sink write function which outputs to a `FILE *` stream (passed as `user_ctx`), e.g. a file on the host
+ */
+void esp_utils_log_sink_stream_write(void *user_ctx, int level, const char *tag, const char *msg, size_t len);
+
+/**
+ * @brief Check if at least one registered sink accepts the level
+ *
+ * @param[in] level Level to check
+ *
+ * @return true if enabled, false otherwise
+ */
+static inline bool esp_utils_log_sink_is_enabled(int level)
+{
+    return (__atomic_load_n(&esp_utils_log_sink_active_mask, __ATOMIC_RELAXED) & ESP_UTILS_LOG_LEVEL_MASK(level)) != 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @brief Dispatch a message to the sinks, the arguments are not evaluated if no sink accepts the level
+ */
+#define ESP_UTILS_LOG_SINK_DISPATCH(level, TAG, format, ...) do {                      \
+        if (esp_utils_log_sink_is_enabled(level)) {                                   \
+            esp_utils_log_sink_dispatch(level, TAG, format, ##__VA_ARGS__);           \
+        }                                                                             \
+    } while (0)
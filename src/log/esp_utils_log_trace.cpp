@@ -0,0 +1,385 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include "esp_utils_conf_internal.h"
+#if ESP_UTILS_CONF_LOG_ENABLE_TRACE_RECORD
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+#if defined(ESP_PLATFORM)
+#   include "freertos/FreeRTOS.h"
+#   include "freertos/task.h"
+#else
+#   include <pthread.h>
+#endif
+#include "esp_utils_log.h"
+#include "esp_utils_log.hpp"
+#include "esp_utils_log_trace.hpp"
+
+namespace esp_utils {
+namespace log_trace {
+
+namespace {
+
+constexpr size_t THREAD_NAME_SIZE = 16;
+constexpr uint32_t BUFFER_SIZE = ESP_UTILS_CONF_LOG_TRACE_RECORD_BUFFER_SIZE;
+// Events copied at once by `exportChromeTrace()`, which writes them without holding `buffers_mutex`
+constexpr size_t EXPORT_BATCH_SIZE = 16;
+
+struct Event {
+    uint64_t begin_ns;
+    uint64_t end_ns;
+    const Site *site;
+    const void *this_ptr;
+};
+
+struct ThreadBuffer {
+    Event events[BUFFER_SIZE];
+    // Total number of recorded scopes, only written by the owner thread
+    std::atomic<uint32_t> count{0};
+    // Cleared when the owner thread exits, the buffer can then be reused by a new thread
+    std::atomic<bool> alive{true};
+    uint32_t tid = 0;
+    char name[THREAD_NAME_SIZE] = {};
+};
+
+std::atomic<bool> record_enabled{true};
+// Incremented by `release()`, so threads know their buffer has been freed
+std::atomic<uint32_t> buffers_generation{0};
+std::mutex buffers_mutex;
+// Buffers are only freed by `release()`, so the records of exited threads can still be exported
+std::vector<ThreadBuffer *> buffers;
+uint32_t next_tid = 1;
+// Incremented by `clear()`, so `exportChromeTrace()` knows the records it is exporting have been discarded
+uint32_t clear_count = 0;
+
+struct ThreadBufferHolder {
+    ThreadBuffer *buffer = nullptr;
+    uint32_t generation = 0;
+    bool failed = false;
+
+    ~ThreadBufferHolder()
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        if ((buffer != nullptr) && (generation == buffers_generation.load(std::memory_order_relaxed))) {
+            buffer->alive.store(false, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadBufferHolder thread_holder;
+
+void getThreadName(char *name, size_t size, uint32_t tid)
+{
+#if defined(ESP_PLATFORM)
+    const char *task_name = pcTaskGetName(nullptr);
+    snprintf(name, size, "%s", (task_name != nullptr) ? task_name : "task");
+#elif defined(__GLIBC__)
+    if (pthread_getname_np(pthread_self(), name, size) != 0) {
+        snprintf(name, size, "thread %u", static_cast<unsigned>(tid));
+    }
+#else
+    snprintf(name, size, "thread %u", static_cast<unsigned>(tid));
+#endif
+}
+
+ThreadBuffer *acquireThreadBuffer()
+{
+    uint32_t generation = buffers_generation.load(std::memory_order_acquire);
+    if (thread_holder.generation != generation) {
+        thread_holder = {nullptr, generation, false};
+    }
+    if ((thread_holder.buffer != nullptr) || thread_holder.failed) {
+        return thread_holder.buffer;
+    }
+
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+
+    ThreadBuffer *buffer = nullptr;
+    for (auto *candidate : buffers) {
+        if (!candidate->alive.load(std::memory_order_acquire)) {
+            buffer = candidate;
+            buffer->count.store(0, std::memory_order_relaxed);
+            buffer->alive.store(true, std::memory_order_relaxed);
+            break;
+        }
+    }
+    if (buffer == nullptr) {
+        buffer = new (std::nothrow) ThreadBuffer();
+        if (buffer == nullptr) {
+            thread_holder.failed = true;
+            return nullptr;
+        }
+        buffers.push_back(buffer);
+    }
+    buffer->tid = next_tid++;
+    getThreadName(buffer->name, sizeof(buffer->name), buffer->tid);
+    thread_holder.buffer = buffer;
+
+    return buffer;
+}
+
+size_t escapeJson(const char *str, char *out, size_t size)
+{
+    size_t len = 0;
+
+    for (; (str != nullptr) && (*str != '\0') && (len + 2 < size); str++) {
+        char c = *str;
+        if ((c == '"') || (c == '\\')) {
+            out[len++] = '\\';
+            out[len++] = c;
+        } else if (static_cast<unsigned char>(c) >= 0x20) {
+            out[len++] = c;
+        }
+    }
+    out[len] = '\0';
+
+    return len;
+}
+
+class JsonWriter {
+public:
+    JsonWriter(WriteFunc func, void *user_ctx)
+        : _func(func)
+        , _user_ctx(user_ctx)
+    {
+    }
+
+    void write(const char *str)
+    {
+        _func(_user_ctx, str, strlen(str));
+    }
+
+    void beginEvent()
+    {
+        write(_first ? "\n" : ",\n");
+        _first = false;
+    }
+
+private:
+    WriteFunc _func = nullptr;
+    void *_user_ctx = nullptr;
+    bool _first = true;
+};
+
+void writeStream(void *user_ctx, const char *data, size_t len)
+{
+    fwrite(data, 1, len, static_cast<FILE *>(user_ctx));
+}
+
+// Scopes of a buffer which are left to export, `[next, end)`
+struct ExportCursor {
+    uint32_t tid;
+    uint32_t clear_count;
+    uint32_t next;
+    uint32_t end;
+    // No other thread records into the buffer: its owner is the exporting thread or has exited
+    bool quiescent;
+    char name[THREAD_NAME_SIZE];
+};
+
+// Called with `buffers_mutex` held, the scopes recorded afterwards are not exported
+ExportCursor beginExport(const ThreadBuffer &buffer)
+{
+    ExportCursor cursor = {};
+    cursor.tid = buffer.tid;
+    cursor.clear_count = clear_count;
+    cursor.end = buffer.count.load(std::memory_order_acquire);
+    cursor.next = (cursor.end > BUFFER_SIZE) ? (cursor.end - BUFFER_SIZE) : 0;
+    cursor.quiescent = (&buffer == thread_holder.buffer) || !buffer.alive.load(std::memory_order_acquire);
+    memcpy(cursor.name, buffer.name, sizeof(cursor.name));
+
+    return cursor;
+}
+
+// Called with `buffers_mutex` held. The owner thread may keep recording meanwhile, so the count is read again after
+// copying, as a sequence lock, and the events it may have overwritten are dropped. As it may also be writing the slot
+// of the oldest event of a full buffer, that one is dropped too unless the buffer is quiescent.
+// Returns the number of copied events, 0 once the cursor is done or the buffer has been cleared or reused
+size_t copyEvents(const ThreadBuffer &buffer, ExportCursor &cursor, Event *events)
+{
+    if ((buffer.tid != cursor.tid) || (cursor.clear_count != clear_count)) {
+        return 0;
+    }
+
+    while (cursor.next < cursor.end) {
+        uint32_t count = buffer.count.load(std::memory_order_acquire);
+        if (count - cursor.next > BUFFER_SIZE) {
+            cursor.next = count - BUFFER_SIZE;
+            if (cursor.next >= cursor.end) {
+                break;
+            }
+        }
+        size_t event_num = std::min<size_t>(cursor.end - cursor.next, EXPORT_BATCH_SIZE);
+        for (size_t i = 0; i < event_num; i++) {
+            events[i] = buffer.events[(cursor.next + i) % BUFFER_SIZE];
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        count = buffer.count.load(std::memory_order_relaxed);
+        size_t dropped = 0;
+        if (!cursor.quiescent && (count >= cursor.next + BUFFER_SIZE)) {
+            dropped = std::min<size_t>(count - (cursor.next + BUFFER_SIZE) + 1, event_num);
+            memmove(events, events + dropped, (event_num - dropped) * sizeof(Event));
+        }
+        cursor.next += event_num;
+        if (dropped < event_num) {
+            return event_num - dropped;
+        }
+    }
+
+    return 0;
+}
+
+} // namespace
+
+uint64_t getTimeNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch()
+                                 ).count());
+}
+
+void record(const Site *site, uint64_t begin_ns, uint64_t end_ns, const void *this_ptr)
+{
+    ThreadBuffer *buffer = acquireThreadBuffer();
+    if ((buffer == nullptr) || (site == nullptr)) {
+        return;
+    }
+
+    uint32_t count = buffer->count.load(std::memory_order_relaxed);
+    buffer->events[count % BUFFER_SIZE] = {begin_ns, end_ns, site, this_ptr};
+    buffer->count.store(count + 1, std::memory_order_release);
+}
+
+void setEnabled(bool enabled)
+{
+    record_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool isEnabled()
+{
+    return record_enabled.load(std::memory_order_relaxed);
+}
+
+void clear()
+{
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    for (auto *buffer : buffers) {
+        buffer->count.store(0, std::memory_order_relaxed);
+    }
+    clear_count++;
+}
+
+void release()
+{
+    std::lock_guard<std::mutex> lock(buffers_mutex);
+    for (auto *buffer : buffers) {
+        delete buffer;
+    }
+    buffers.clear();
+    buffers.shrink_to_fit();
+    next_tid = 1;
+    buffers_generation.fetch_add(1, std::memory_order_release);
+}
+
+size_t exportChromeTrace(WriteFunc func, void *user_ctx)
+{
+    if (func == nullptr) {
+        return 0;
+    }
+
+    JsonWriter writer(func, user_ctx);
+    Event events[EXPORT_BATCH_SIZE];
+    char line[384];
+    char name[128];
+    char file[96];
+    char tag[32];
+    uint32_t generation = buffers_generation.load(std::memory_order_acquire);
+    size_t exported = 0;
+
+    writer.write("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    for (size_t index = 0; ; index++) {
+        ExportCursor cursor = {};
+        size_t event_num = 0;
+        {
+            std::lock_guard<std::mutex> lock(buffers_mutex);
+            if ((generation != buffers_generation.load(std::memory_order_relaxed)) || (index >= buffers.size())) {
+                break;
+            }
+            cursor = beginExport(*buffers[index]);
+            event_num = copyEvents(*buffers[index], cursor, events);
+        }
+
+        escapeJson(cursor.name, name, sizeof(name));
+        snprintf(
+            line, sizeof(line), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+            static_cast<unsigned>(cursor.tid), name
+        );
+        writer.beginEvent();
+        writer.write(line);
+
+        while (event_num > 0) {
+            for (size_t i = 0; i < event_num; i++) {
+                const Event &event = events[i];
+                const Site *site = event.site;
+                std::string func_name = detail::parseFunctionName(site->function);
+                escapeJson(func_name.empty() ? site->function : func_name.c_str(), name, sizeof(name));
+                escapeJson(esp_utils_log_extract_file_name(site->file), file, sizeof(file));
+                escapeJson(site->tag, tag, sizeof(tag));
+                uint64_t duration_ns = (event.end_ns > event.begin_ns) ? (event.end_ns - event.begin_ns) : 0;
+
+                int len = snprintf(
+                              line, sizeof(line),
+                              "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu.%03u,"
+                              "\"dur\":%llu.%03u,\"args\":{\"file\":\"%s:%d\"",
+                              name, tag, static_cast<unsigned>(cursor.tid),
+                              static_cast<unsigned long long>(event.begin_ns / 1000),
+                              static_cast<unsigned>(event.begin_ns % 1000),
+                              static_cast<unsigned long long>(duration_ns / 1000),
+                              static_cast<unsigned>(duration_ns % 1000), file, site->line
+                          );
+                if ((len > 0) && (event.this_ptr != nullptr) && (static_cast<size_t>(len) < sizeof(line))) {
+                    snprintf(line + len, sizeof(line) - len, ",\"this\":\"%p\"", event.this_ptr);
+                }
+                writer.beginEvent();
+                writer.write(line);
+                writer.write("}}");
+                exported++;
+            }
+
+            std::lock_guard<std::mutex> lock(buffers_mutex);
+            if (generation != buffers_generation.load(std::memory_order_relaxed)) {
+                break;
+            }
+            event_num = copyEvents(*buffers[index], cursor, events);
+        }
+    }
+    writer.write("\n]}\n");
+
+    return exported;
+}
+
+size_t exportChromeTrace(FILE *stream)
+{
+    if (stream == nullptr) {
+        return 0;
+    }
+
+    size_t exported = exportChromeTrace(writeStream, stream);
+    fflush(stream);
+
+    return exported;
+}
+
+} // namespace log_trace
+} // namespace esp_utils
+
+#endif // ESP_UTILS_CONF_LOG_ENABLE_TRACE_RECORD
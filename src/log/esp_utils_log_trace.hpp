@@ -0,0 +1,139 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include "esp_utils_conf_internal.h"
+
+namespace esp_utils {
+namespace log_trace {
+
+/**
+ * @brief Description of an instrumented scope, one constant instance is generated for each trace guard
+ */
+struct Site {
+    const char *tag;        /*!< Log tag of the scope */
+    const char *function;   /*!< Signature of the function (`__PRETTY_FUNCTION__`) */
+    const char *file;       /*!< File of the guard */
+    int line;               /*!< Line of the guard */
+};
+
+/**
+ * @brief Function to output a chunk of the exported trace
+ *
+ * @param[in] user_ctx User context passed to `exportChromeTrace()`
+ * @param[in] data     Chunk data, not null-terminated
+ * @param[in] len      Length of `data`
+ */
+using WriteFunc = void (*)(void *user_ctx, const char *data, size_t len);
+
+/**
+ * @brief Get the monotonic time used for the records
+ *
+ * @return Time in nanoseconds
+ */
+uint64_t getTimeNs();
+
+/**
+ * @brief Record a finished scope into the buffer of the calling thread
+ *
+ * @param[in] site     Description of the scope
+ * @param[in] begin_ns Enter time, see `getTimeNs()`
+ * @param[in] end_ns   Exit time, see `getTimeNs()`
+ * @param[in] this_ptr Object the scope belongs to, can be nullptr
+ */
+void record(const Site *site, uint64_t begin_ns, uint64_t end_ns, const void *this_ptr);
+
+/**
+ * @brief Pause or resume recording (enabled by default), pause it before exporting to get a consistent snapshot
+ *
+ * @param[in] enabled true to resume, false to pause
+ */
+void setEnabled(bool enabled);
+
+/**
+ * @brief Check if recording is enabled
+ *
+ * @return true if enabled, false otherwise
+ */
+bool isEnabled();
+
+/**
+ * @brief Discard the records of all threads
+ */
+void clear();
+
+/**
+ * @brief Discard the records and free the buffers of all threads, they will be allocated again on the next record
+ *
+ * @note  It must not be called while instrumented code is running in other threads
+ */
+void release();
+
+/**
+ * @brief Export the records of all threads as Chrome Trace Event JSON, which can be opened in `chrome://tracing`
+ *        or https://ui.perfetto.dev
+ *
+ * @note  The other threads can keep recording: the scopes recorded after the export of their thread started are not
+ *        exported, and the ones they overwrite before being exported are skipped
+ * @note  The records are copied in small batches, `func` is called without holding any lock
+ *
+ * @param[in] func     Function to output the JSON text
+ * @param[in] user_ctx User context passed to `func`
+ *
+ * @return Number of exported scopes
+ */
+size_t exportChromeTrace(WriteFunc func, void *user_ctx);
+
+/**
+ * @brief Export the records of all threads as Chrome Trace Event JSON into a stream (e.g. a file or `stdout`)
+ *
+ * @param[in] stream Stream to write
+ *
+ * @return Number of exported scopes
+ */
+size_t exportChromeTrace(FILE *stream);
+
+/**
+ * @brief RAII class to record the duration of a scope, created by `ESP_UTILS_LOG_TRACE_GUARD()`
+ */
+class ScopeRecorder {
+public:
+    explicit ScopeRecorder(const Site *site, const void *this_ptr = nullptr)
+        : _site(isEnabled() ? site : nullptr)
+        , _this_ptr(this_ptr)
+        , _begin_ns((_site != nullptr) ? getTimeNs() : 0)
+    {
+    }
+
+    ~ScopeRecorder()
+    {
+        if (_site != nullptr) {
+            record(_site, _begin_ns, getTimeNs(), _this_ptr);
+        }
+    }
+
+    ScopeRecorder(const ScopeRecorder &) = delete;
+    ScopeRecorder(ScopeRecorder &&) = delete;
+    ScopeRecorder &operator=(const ScopeRecorder &) = delete;
+    ScopeRecorder &operator=(ScopeRecorder &&) = delete;
+
+private:
+    const Site *_site = nullptr;
+    const void *_this_ptr = nullptr;
+    uint64_t _begin_ns = 0;
+};
+
+} // namespace log_trace
+} // namespace esp_utils
+
+#define ESP_UTILS_LOG_TRACE_RECORD_GUARD(this_ptr)                                                          \
+    static const esp_utils::log_trace::Site _log_trace_site_{                                                 \
+        ESP_UTILS_LOG_TAG, __PRETTY_FUNCTION__, __FILE__, __LINE__                                            \
+    };                                                                                                      \
+    esp_utils::log_trace::ScopeRecorder _log_trace_guard_{&_log_trace_site_, this_ptr}
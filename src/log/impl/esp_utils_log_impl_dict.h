@@ -0,0 +1,27 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include "../esp_utils_log_dict.h"
+
+#define ESP_UTILS_LOGD_IMPL_FUNC(TAG, format, ...) \
+    ESP_UTILS_LOG_DICT_WRITE_TAG(ESP_UTILS_LOG_LEVEL_DEBUG, TAG, format, ##__VA_ARGS__)
+#define ESP_UTILS_LOGI_IMPL_FUNC(TAG, format, ...) \
+    ESP_UTILS_LOG_DICT_WRITE_TAG(ESP_UTILS_LOG_LEVEL_INFO, TAG, format, ##__VA_ARGS__)
+#define ESP_UTILS_LOGW_IMPL_FUNC(TAG, format, ...) \
+    ESP_UTILS_LOG_DICT_WRITE_TAG(ESP_UTILS_LOG_LEVEL_WARNING, TAG, format, ##__VA_ARGS__)
+#define ESP_UTILS_LOGE_IMPL_FUNC(TAG, format, ...) \
+    ESP_UTILS_LOG_DICT_WRITE_TAG(ESP_UTILS_LOG_LEVEL_ERROR, TAG, format, ##__VA_ARGS__)
+
+// The location is stored in the call-site descriptor, so it is not part of the frame
+#define ESP_UTILS_LOGD_IMPL(TAG, format, ...) \
+    ESP_UTILS_LOG_DICT_WRITE(ESP_UTILS_LOG_LEVEL_DEBUG, TAG, format, ##__VA_ARGS__)
+#define ESP_UTILS_LOGI_IMPL(TAG, format, ...) \
+    ESP_UTILS_LOG_DICT_WRITE(ESP_UTILS_LOG_LEVEL_INFO, TAG, format, ##__VA_ARGS__)
+#define ESP_UTILS_LOGW_IMPL(TAG, format, ...) \
+    ESP_UTILS_LOG_DICT_WRITE(ESP_UTILS_LOG_LEVEL_WARNING, TAG, format, ##__VA_ARGS__)
+#define ESP_UTILS_LOGE_IMPL(TAG, format, ...) \
+    ESP_UTILS_LOG_DICT_WRITE(ESP_UTILS_LOG_LEVEL_ERROR, TAG, format, ##__VA_ARGS__)
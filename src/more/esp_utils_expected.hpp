@@ -0,0 +1,496 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cassert>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#if defined(ESP_PLATFORM)
+#   include "esp_err.h"
+#endif
+#include "check/esp_utils_check.h"
+
+namespace esp_utils {
+
+/**
+ * @brief Error wrapper to construct a failed `Expected`, see `makeUnexpected()`
+ *
+ * @tparam E Error type
+ */
+template <typename E>
+class Unexpected {
+public:
+    constexpr explicit Unexpected(const E &error)
+        : _error(error)
+    {
+    }
+
+    constexpr explicit Unexpected(E &&error)
+        : _error(std::move(error))
+    {
+    }
+
+    constexpr const E &error() const &
+    {
+        return _error;
+    }
+
+    constexpr E &error() &
+    {
+        return _error;
+    }
+
+    constexpr E &&error() &&
+    {
+        return std::move(_error);
+    }
+
+private:
+    E _error;
+};
+
+template <typename E>
+Unexpected(E) -> Unexpected<E>;
+
+/**
+ * @brief Create an `Unexpected` from an error, e.g. `return makeUnexpected(ESP_ERR_NO_MEM);`
+ */
+template <typename E>
+constexpr Unexpected<std::decay_t<E>> makeUnexpected(E &&error)
+{
+    return Unexpected<std::decay_t<E>>(std::forward<E>(error));
+}
+
+namespace detail {
+
+struct ExpectedEmpty {};
+struct ExpectedValueTag {};
+struct ExpectedErrorTag {};
+
+/**
+ * The storage keeps the special members trivial when both types are trivial, so that small results are passed in
+ * registers like plain values
+ */
+template <
+    typename T, typename E, bool = std::conjunction_v<std::is_trivially_copyable<T>, std::is_trivially_copyable<E>>
+    >
+struct ExpectedStorage {
+    template <typename... Args>
+    constexpr explicit ExpectedStorage(ExpectedValueTag, Args &&... args)
+        : value(std::forward<Args>(args)...)
+        , has_value(true)
+    {
+    }
+
+    template <typename... Args>
+    constexpr explicit ExpectedStorage(ExpectedErrorTag, Args &&... args)
+        : error(std::forward<Args>(args)...)
+        , has_value(false)
+    {
+    }
+
+    union {
+        T value;
+        E error;
+    };
+    bool has_value;
+};
+
+template <typename T, typename E>
+struct ExpectedStorage<T, E, false> {
+    template <typename... Args>
+    explicit ExpectedStorage(ExpectedValueTag, Args &&... args)
+        : value(std::forward<Args>(args)...)
+        , has_value(true)
+    {
+    }
+
+    template <typename... Args>
+    explicit ExpectedStorage(ExpectedErrorTag, Args &&... args)
+        : error(std::forward<Args>(args)...)
+        , has_value(false)
+    {
+    }
+
+    ExpectedStorage(const ExpectedStorage &other)
+        : has_value(other.has_value)
+    {
+        constructFrom(other);
+    }
+
+    ExpectedStorage(ExpectedStorage &&other) noexcept(
+        std::conjunction_v<std::is_nothrow_move_constructible<T>, std::is_nothrow_move_constructible<E>>
+    )
+        : has_value(other.has_value)
+    {
+        constructFrom(std::move(other));
+    }
+
+    ExpectedStorage &operator=(const ExpectedStorage &other)
+    {
+        if (this != &other) {
+            destroy();
+            has_value = other.has_value;
+            constructFrom(other);
+        }
+        return *this;
+    }
+
+    ExpectedStorage &operator=(ExpectedStorage &&other) noexcept(
+        std::conjunction_v<std::is_nothrow_move_constructible<T>, std::is_nothrow_move_constructible<E>>
+    )
+    {
+        if (this != &other) {
+            destroy();
+            has_value = other.has_value;
+            constructFrom(std::move(other));
+        }
+        return *this;
+    }
+
+    ~ExpectedStorage()
+    {
+        destroy();
+    }
+
+    union {
+        T value;
+        E error;
+    };
+    bool has_value;
+
+private:
+    template <typename Other>
+    void constructFrom(Other &&other)
+    {
+        if (has_value) {
+            new (std::addressof(value)) T(std::forward<Other>(other).value);
+        } else {
+            new (std::addressof(error)) E(std::forward<Other>(other).error);
+        }
+    }
+
+    void destroy()
+    {
+        if (has_value) {
+            value.~T();
+        } else {
+            error.~E();
+        }
+    }
+};
+
+template <typename T>
+struct IsUnexpected: std::false_type {};
+
+template <typename E>
+struct IsUnexpected<Unexpected<E>>: std::true_type {};
+
+template <typename T, typename R>
+using EnableIfNonVoid = std::enable_if_t<std::negation_v<std::is_void<T>>, R>;
+
+} // namespace detail
+
+/**
+ * @brief Result type which holds either a value or an error, without exceptions and heap allocation
+ *
+ * @note  Accessing the value of a failed result (or the error of a successful one) triggers an assertion
+ *
+ * @tparam T Value type, can be `void`
+ * @tparam E Error type
+ */
+template <typename T, typename E>
+class Expected {
+    using Stored = std::conditional_t<std::is_void_v<T>, detail::ExpectedEmpty, T>;
+
+    static_assert(!std::is_reference_v<T>, "Expected value type can't be a reference");
+    static_assert(!std::is_reference_v<E> && !std::is_void_v<E>, "Expected error type must be an object type");
+
+public:
+    using ValueType = T;
+    using ErrorType = E;
+
+    template <typename U = Stored, typename = std::enable_if_t<std::is_default_constructible_v<U>>>
+    constexpr Expected()
+        : _storage(detail::ExpectedValueTag{})
+    {
+    }
+
+    template <typename U = Stored, typename = std::enable_if_t<std::conjunction_v<
+                  std::negation<std::is_void<T>>, std::is_constructible<Stored, U>,
+                  std::negation<std::is_same<std::decay_t<U>, Expected>>,
+                  std::negation<detail::IsUnexpected<std::decay_t<U>>>
+                  >>>
+    constexpr Expected(U &&value)
+        : _storage(detail::ExpectedValueTag{}, std::forward<U>(value))
+    {
+    }
+
+    template <typename G, typename = std::enable_if_t<std::is_constructible_v<E, const G &>>>
+    constexpr Expected(const Unexpected<G> &unexpected)
+        : _storage(detail::ExpectedErrorTag{}, unexpected.error())
+    {
+    }
+
+    template <typename G, typename = std::enable_if_t<std::is_constructible_v<E, G &&>>>
+    constexpr Expected(Unexpected<G> &&unexpected)
+        : _storage(detail::ExpectedErrorTag{}, std::move(unexpected).error())
+    {
+    }
+
+    constexpr bool hasValue() const
+    {
+        return _storage.has_value;
+    }
+
+    constexpr explicit operator bool() const
+    {
+        return hasValue();
+    }
+
+    template <typename U = T>
+    constexpr detail::EnableIfNonVoid<U, U &> value() &
+    {
+        assert(hasValue());
+        return _storage.value;
+    }
+
+    template <typename U = T>
+    constexpr detail::EnableIfNonVoid<U, const U &> value() const &
+    {
+        assert(hasValue());
+        return _storage.value;
+    }
+
+    template <typename U = T>
+    constexpr detail::EnableIfNonVoid<U, U &&> value() &&
+    {
+        assert(hasValue());
+        return std::move(_storage.value);
+    }
+
+    template <typename U = T>
+    constexpr detail::EnableIfNonVoid<U, U &> operator*() &
+    {
+        return value();
+    }
+
+    template <typename U = T>
+    constexpr detail::EnableIfNonVoid<U, const U &> operator*() const &
+    {
+        return value();
+    }
+
+    template <typename U = T>
+    constexpr detail::EnableIfNonVoid<U, U &&> operator*() &&
+    {
+        return std::move(*this).value();
+    }
+
+    template <typename U = T>
+    constexpr detail::EnableIfNonVoid<U, U *> operator->()
+    {
+        return std::addressof(value());
+    }
+
+    template <typename U = T>
+    constexpr detail::EnableIfNonVoid<U, const U *> operator->() const
+    {
+        return std::addressof(value());
+    }
+
+    constexpr const E &error() const &
+    {
+        assert(!hasValue());
+        return _storage.error;
+    }
+
+    constexpr E &error() &
+    {
+        assert(!hasValue());
+        return _storage.error;
+    }
+
+    constexpr E &&error() &&
+    {
+        assert(!hasValue());
+        return std::move(_storage.error);
+    }
+
+    /**
+     * @brief Get the value, or `default_value` if the result is an error
+     */
+    template <typename U>
+    constexpr T valueOr(U &&default_value) const &
+    {
+        return hasValue() ? _storage.value : static_cast<T>(std::forward<U>(default_value));
+    }
+
+    template <typename U>
+    constexpr T valueOr(U &&default_value) &&
+    {
+        return hasValue() ? std::move(_storage.value) : static_cast<T>(std::forward<U>(default_value));
+    }
+
+    /**
+     * @brief Chain an operation which can fail, `func` takes the value (nothing for `void`) and returns an
+     *        `Expected` with the same error type. The error is forwarded without calling `func`
+     */
+    template <typename Func>
+    constexpr auto andThen(Func &&func) &&
+    {
+        using Result = std::decay_t<decltype(invoke(std::forward<Func>(func), std::move(*this)))>;
+        if (!hasValue()) {
+            return Result(makeUnexpected(std::move(_storage.error)));
+        }
+        return invoke(std::forward<Func>(func), std::move(*this));
+    }
+
+    template <typename Func>
+    constexpr auto andThen(Func &&func) const &
+    {
+        using Result = std::decay_t<decltype(invoke(std::forward<Func>(func), *this))>;
+        if (!hasValue()) {
+            return Result(makeUnexpected(_storage.error));
+        }
+        return invoke(std::forward<Func>(func), *this);
+    }
+
+    /**
+     * @brief Convert the value with `func` (which takes the value, or nothing for `void`), the error is forwarded
+     */
+    template <typename Func>
+    constexpr auto transform(Func &&func) &&
+    {
+        using U = std::remove_cv_t<decltype(invoke(std::forward<Func>(func), std::move(*this)))>;
+        if (!hasValue()) {
+            return Expected<U, E>(makeUnexpected(std::move(_storage.error)));
+        }
+        if constexpr (std::is_void_v<U>) {
+            invoke(std::forward<Func>(func), std::move(*this));
+            return Expected<U, E>();
+        } else {
+            return Expected<U, E>(invoke(std::forward<Func>(func), std::move(*this)));
+        }
+    }
+
+    /**
+     * @brief Convert the error with `func`, the value is forwarded
+     */
+    template <typename Func>
+    constexpr auto transformError(Func &&func) &&
+    {
+        using G = std::remove_cv_t<std::invoke_result_t<Func, E &&>>;
+        if (!hasValue()) {
+            return Expected<T, G>(makeUnexpected(std::forward<Func>(func)(std::move(_storage.error))));
+        }
+        if constexpr (std::is_void_v<T>) {
+            return Expected<T, G>();
+        } else {
+            return Expected<T, G>(std::move(_storage.value));
+        }
+    }
+
+private:
+    template <typename Func, typename Self>
+    static constexpr decltype(auto) invoke(Func &&func, Self &&self)
+    {
+        if constexpr (std::is_void_v<T>) {
+            return std::forward<Func>(func)();
+        } else {
+            return std::forward<Func>(func)(std::forward<Self>(self)._storage.value);
+        }
+    }
+
+    detail::ExpectedStorage<Stored, E> _storage;
+};
+
+#if defined(ESP_PLATFORM)
+/**
+ * @brief Result type with an ESP-IDF error code
+ */
+template <typename T>
+using EspExpected = Expected<T, esp_err_t>;
+#endif
+
+} // namespace esp_utils
+
+#define _ESP_UTILS_TRY_CONCAT_IMPL(a, b)  a##b
+#define _ESP_UTILS_TRY_CONCAT(a, b)       _ESP_UTILS_TRY_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Evaluate an `Expected`; if it holds an error, handle it like a failed check and return the error from the
+ *        current function, whose return type must be an `Expected` constructible from that error
+ *
+ * @param x   Expression returning an `Expected`
+ * @param fmt Format string for the error message
+ * @param ... Additional arguments for the format string
+ */
+#define ESP_UTILS_TRY(x, fmt, ...) do {                                                                   \
+            auto &&_esp_utils_try_ = (x);                                                                 \
+            if (unlikely(!_esp_utils_try_.hasValue())) {                                                  \
+                ESP_UTILS_CHECK_HANDLE_FAILURE(fmt, ##__VA_ARGS__);                                       \
+                return esp_utils::makeUnexpected(                                                         \
+                    std::forward<decltype(_esp_utils_try_)>(_esp_utils_try_).error()                       \
+                );                                                                                        \
+            }                                                                                             \
+        } while(0)
+
+#define _ESP_UTILS_TRY_ASSIGN_IMPL(tmp, lhs, x, fmt, ...)                                                 \
+        auto &&tmp = (x);                                                                                 \
+        if (unlikely(!tmp.hasValue())) {                                                                  \
+            ESP_UTILS_CHECK_HANDLE_FAILURE(fmt, ##__VA_ARGS__);                                           \
+            return esp_utils::makeUnexpected(std::forward<decltype(tmp)>(tmp).error());                   \
+        }                                                                                                 \
+        lhs = *std::forward<decltype(tmp)>(tmp)
+
+/**
+ * @brief Like `ESP_UTILS_TRY()`, and assign the value to `lhs` on success. `lhs` can be a declaration, e.g.
+ *        `ESP_UTILS_TRY_ASSIGN(int value, parse(str), "Parse failed");`
+ *
+ * @param lhs Variable or declaration to assign
+ * @param x   Expression returning an `Expected`
+ * @param fmt Format string for the error message
+ * @param ... Additional arguments for the format string
+ */
+#define ESP_UTILS_TRY_ASSIGN(lhs, x, fmt, ...) \
+        _ESP_UTILS_TRY_ASSIGN_IMPL(_ESP_UTILS_TRY_CONCAT(_esp_utils_try_, __LINE__), lhs, x, fmt, ##__VA_ARGS__)
+
+/**
+ * @brief Check if an `Expected` holds an error; if it does, handle it like a failed check and return the specified
+ *        value
+ *
+ * @param x   Expression returning an `Expected`
+ * @param ret Value to return if it holds an error
+ * @param fmt Format string for the error message
+ * @param ... Additional arguments for the format string
+ */
+#define ESP_UTILS_CHECK_EXPECTED_RETURN(x, ret, fmt, ...) \
+        ESP_UTILS_CHECK_FALSE_RETURN((x).hasValue(), ret, fmt, ##__VA_ARGS__)
+
+/**
+ * @brief Check if an `Expected` holds an error; if it does, handle it like a failed check and goto the specified
+ *        label
+ *
+ * @param x        Expression returning an `Expected`
+ * @param goto_tag Label to jump to if it holds an error
+ * @param fmt      Format string for the error message
+ * @param ...      Additional arguments for the format string
+ */
+#define ESP_UTILS_CHECK_EXPECTED_GOTO(x, goto_tag, fmt, ...) \
+        ESP_UTILS_CHECK_FALSE_GOTO((x).hasValue(), goto_tag, fmt, ##__VA_ARGS__)
+
+/**
+ * @brief Check if an `Expected` holds an error; if it does, handle it like a failed check and return without a value
+ *
+ * @param x   Expression returning an `Expected`
+ * @param fmt Format string for the error message
+ * @param ... Additional arguments for the format string
+ */
+#define ESP_UTILS_CHECK_EXPECTED_EXIT(x, fmt, ...) \
+        ESP_UTILS_CHECK_FALSE_EXIT((x).hasValue(), fmt, ##__VA_ARGS__)
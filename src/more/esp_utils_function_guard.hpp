@@ -14,7 +14,7 @@ template<typename T, typename... Args>
 class function_guard {
 public:
     function_guard(T func, Args &&... args)
-        : func_(func)
+        : func_(std::move(func))
         , args_(std::forward<Args>(args)...)
     {}
 
@@ -0,0 +1,265 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace esp_utils {
+
+/**
+ * @brief Default inline capacity of `inplace_function`, it fits a few captured pointers or a `std::function`
+ */
+constexpr size_t inplace_function_default_capacity = 4 * sizeof(void *);
+
+template <
+    typename Signature, size_t Capacity = inplace_function_default_capacity,
+    size_t Alignment = alignof(std::max_align_t)
+    >
+class inplace_function;
+
+namespace detail {
+
+template <typename T>
+struct IsInplaceFunction: std::false_type {};
+
+template <typename Signature, size_t Capacity, size_t Alignment>
+struct IsInplaceFunction<inplace_function<Signature, Capacity, Alignment>>: std::true_type {};
+
+template <typename T>
+struct IsStdFunction: std::false_type {};
+
+template <typename Signature>
+struct IsStdFunction<std::function<Signature>>: std::true_type {};
+
+/**
+ * Copy, move and destroy the stored callable. `destroy` is nullptr for trivially destructible callables (function
+ * pointers, lambdas capturing pointers or references), so destroying them doesn't make an indirect call
+ */
+struct InplaceFunctionManager {
+    void (*copy)(void *dst, const void *src);
+    void (*move)(void *dst, void *src);         // Also destroys `src`
+    void (*destroy)(void *storage);
+};
+
+template <typename F>
+struct InplaceFunctionManagerOf {
+    static void copy(void *dst, const void *src)
+    {
+        new (dst) F(*static_cast<const F *>(src));
+    }
+
+    static void move(void *dst, void *src)
+    {
+        auto func = static_cast<F *>(src);
+        new (dst) F(std::move(*func));
+        func->~F();
+    }
+
+    static void destroy(void *storage)
+    {
+        static_cast<F *>(storage)->~F();
+    }
+
+    static constexpr InplaceFunctionManager value = {
+        copy, move, std::is_trivially_destructible_v<F> ? nullptr : destroy
+    };
+};
+
+} // namespace detail
+
+/**
+ * @brief Callable wrapper like `std::function`, which stores the callable inline and never allocates. A callable
+ *        larger than `Capacity` is rejected at compile time instead of being moved to the heap, see `fits`
+ *
+ * @note  Calling an empty function is undefined behavior (asserted in debug builds)
+ *
+ * @tparam R Return type
+ * @tparam Args Argument types
+ * @tparam Capacity Size of the inline storage in bytes
+ * @tparam Alignment Alignment of the inline storage
+ */
+template <typename R, typename... Args, size_t Capacity, size_t Alignment>
+class inplace_function<R(Args...), Capacity, Alignment> {
+public:
+    using result_type = R;
+
+    static constexpr size_t capacity = Capacity;
+    static constexpr size_t alignment = Alignment;
+
+    /**
+     * @brief Whether a callable fits in the inline storage, e.g. to wrap the ones which don't into a `std::function`
+     */
+    template <typename Callable>
+    static constexpr bool fits = (sizeof(Callable) <= Capacity) && (Alignment % alignof(Callable) == 0);
+
+    inplace_function() noexcept = default;
+
+    inplace_function(std::nullptr_t) noexcept
+    {
+    }
+
+    /**
+     * @brief Store a callable, e.g. a lambda, a function pointer or a functor
+     *
+     * @param[in] func Callable invocable with `Args...`, and returning a value convertible to `R`
+     */
+    template <
+        typename F, typename Callable = std::decay_t<F>,
+        typename = std::enable_if_t<
+            !detail::IsInplaceFunction<Callable>::value && std::is_invocable_r_v<R, Callable &, Args...>
+            >
+        >
+    inplace_function(F &&func)
+    {
+        static_assert(sizeof(Callable) <= Capacity, "Callable doesn't fit in the inline storage, increase `Capacity`");
+        static_assert(Alignment % alignof(Callable) == 0, "Callable is over-aligned for the inline storage");
+        static_assert(std::is_copy_constructible_v<Callable>, "Callable must be copy constructible");
+
+        // A null pointer or an empty `std::function` makes an empty function, a function reference can't be null
+        using Argument = std::remove_cv_t<std::remove_reference_t<F>>;
+        if constexpr (std::is_pointer_v<Argument> || std::is_member_pointer_v<Argument>) {
+            if (func == nullptr) {
+                return;
+            }
+        } else if constexpr (detail::IsStdFunction<Argument>::value) {
+            if (!func) {
+                return;
+            }
+        }
+        new (_storage) Callable(std::forward<F>(func));
+        _invoke = &invoke<Callable>;
+        _manager = &detail::InplaceFunctionManagerOf<Callable>::value;
+    }
+
+    inplace_function(const inplace_function &other)
+    {
+        copyFrom(other);
+    }
+
+    inplace_function(inplace_function &&other) noexcept
+    {
+        moveFrom(other);
+    }
+
+    ~inplace_function()
+    {
+        destroy();
+    }
+
+    inplace_function &operator=(const inplace_function &other)
+    {
+        if (this != &other) {
+            destroy();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    inplace_function &operator=(inplace_function &&other) noexcept
+    {
+        if (this != &other) {
+            destroy();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    inplace_function &operator=(std::nullptr_t) noexcept
+    {
+        destroy();
+        return *this;
+    }
+
+    template <
+        typename F, typename = std::enable_if_t<std::is_constructible_v<inplace_function, F &&>>
+        >
+    inplace_function &operator=(F &&func)
+    {
+        return *this = inplace_function(std::forward<F>(func));
+    }
+
+    void swap(inplace_function &other) noexcept
+    {
+        inplace_function temp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temp);
+    }
+
+    R operator()(Args... args) const
+    {
+        assert(_invoke != nullptr);
+        return _invoke(_storage, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return _invoke != nullptr;
+    }
+
+    friend bool operator==(const inplace_function &func, std::nullptr_t) noexcept
+    {
+        return !func;
+    }
+
+    friend bool operator!=(const inplace_function &func, std::nullptr_t) noexcept
+    {
+        return static_cast<bool>(func);
+    }
+
+private:
+    using Invoke = R(*)(void *storage, Args &&... args);
+
+    template <typename Callable>
+    static R invoke(void *storage, Args &&... args)
+    {
+        if constexpr (std::is_void_v<R>) {
+            std::invoke(*static_cast<Callable *>(storage), std::forward<Args>(args)...);
+        } else {
+            return std::invoke(*static_cast<Callable *>(storage), std::forward<Args>(args)...);
+        }
+    }
+
+    void copyFrom(const inplace_function &other)
+    {
+        if (other._manager != nullptr) {
+            other._manager->copy(_storage, other._storage);
+        }
+        _invoke = other._invoke;
+        _manager = other._manager;
+    }
+
+    void moveFrom(inplace_function &other) noexcept
+    {
+        if (other._manager != nullptr) {
+            other._manager->move(_storage, other._storage);
+        }
+        _invoke = other._invoke;
+        _manager = other._manager;
+        other._invoke = nullptr;
+        other._manager = nullptr;
+    }
+
+    void destroy() noexcept
+    {
+        if ((_manager != nullptr) && (_manager->destroy != nullptr)) {
+            _manager->destroy(_storage);
+        }
+        _invoke = nullptr;
+        _manager = nullptr;
+    }
+
+    // The callable is invoked as non-const like `std::function`, so a mutable lambda works through a const wrapper
+    alignas(Alignment) mutable unsigned char _storage[Capacity];
+    Invoke _invoke = nullptr;
+    const detail::InplaceFunctionManager *_manager = nullptr;
+};
+
+} // namespace esp_utils
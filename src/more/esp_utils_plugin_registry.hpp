@@ -5,90 +5,1560 @@
  */
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <forward_list>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <typeindex>
+#include <typeinfo>
 #include <memory>
 #include <mutex>
 #include <functional>
 #include <vector>
 #include <algorithm>
 #include <iterator>
+#include <thread>
 #ifdef __GNUG__
 #   include <cxxabi.h>
 #endif
+#if defined(ESP_PLATFORM)
+#   include "freertos/FreeRTOS.h"
+#elif defined(__linux__)
+#   include <sched.h>
+#endif
+#include "esp_utils_function_guard.hpp"
+#include "esp_utils_inplace_function.hpp"
+
+namespace esp_utils {
+
+/**
+ * @brief Interned plugin name, it is only valid for the registry which created it
+ */
+enum class PluginNameId : uint32_t {
+    Invalid = UINT32_MAX,
+};
+
+template <typename T, typename Allocator = std::allocator<T>>
+class PluginRegistry;
+
+template <typename T, typename PluginType, typename Allocator = std::allocator<T>>
+class PluginHandle;
+
+template <typename BaseType, typename PluginType, typename Allocator = std::allocator<BaseType>>
+struct PluginRegistrar;
+
+namespace detail {
+
+/**
+ * @brief Demangle type name for better readability
+ *
+ * @param[in] mangled_name Mangled type name
+ * @return Demangled type name or original name if demangling fails
+ */
+inline std::string demangleTypeName(const char *mangled_name)
+{
+#ifdef __GNUG__
+    int status = 0;
+    std::unique_ptr<char, void(*)(void *)> result {
+        abi::__cxa_demangle(mangled_name, 0, 0, &status),
+        std::free
+    };
+    return (status == 0) ? result.get() : mangled_name;
+#else
+    // For non-GCC compilers, return original mangled name
+    return mangled_name;
+#endif
+}
+
+struct TypeNameCache {
+    std::mutex mutex;
+    std::unordered_map<std::type_index, std::string> names;
+};
+
+// Shared by all registries of the program, a name is demangled once per type
+inline const std::string &getTypeName(std::type_index type)
+{
+    static TypeNameCache cache;
+    std::lock_guard<std::mutex> lock(cache.mutex);
+
+    auto it = cache.names.find(type);
+    if (it == cache.names.end()) {
+        it = cache.names.emplace(type, demangleTypeName(type.name())).first;
+    }
+    // The nodes of the map are never moved or erased
+    return it->second;
+}
+
+} // namespace detail
+
+/**
+ * @brief Real type name (demangled) of a plugin. Only the type is stored, it is demangled on first use and cached for
+ *        the whole program
+ */
+class PluginTypeName {
+public:
+    PluginTypeName()
+        : _type(typeid(void)) {}
+
+    explicit PluginTypeName(std::type_index type)
+        : _type(type) {}
+
+    /**
+     * @brief Get the demangled name
+     *
+     * @return Demangled name, it stays valid as long as the program runs
+     */
+    const std::string &str() const
+    {
+        return detail::getTypeName(_type);
+    }
+
+    const char *c_str() const
+    {
+        return str().c_str();
+    }
+
+    operator const std::string &() const
+    {
+        return str();
+    }
+
+    bool operator==(const PluginTypeName &other) const
+    {
+        return _type == other._type;
+    }
+
+    bool operator!=(const PluginTypeName &other) const
+    {
+        return _type != other._type;
+    }
+
+    template <typename Stream>
+    friend Stream &operator<<(Stream &stream, const PluginTypeName &type_name)
+    {
+        stream << type_name.str();
+        return stream;
+    }
+
+private:
+    std::type_index _type;
+};
+
+/**
+ * @brief Which callers share an instance of a plugin, see `PluginRegistry::registerPlugin()`
+ */
+enum class PluginScope {
+    Global,                             ///< One instance shared by all callers
+    PerCore,                            ///< One instance per CPU core, for the core running the caller
+    PerThread,                          ///< One instance per thread (or task)
+};
+
+namespace detail {
+
+inline size_t getPluginCoreNum()
+{
+#if defined(ESP_PLATFORM)
+    return portNUM_PROCESSORS;
+#else
+    static const size_t core_num = std::max(std::thread::hardware_concurrency(), 1U);
+    return core_num;
+#endif
+}
+
+inline size_t getPluginCoreId()
+{
+#if defined(ESP_PLATFORM)
+    return static_cast<size_t>(xPortGetCoreID());
+#elif defined(__linux__)
+    // The CPU number can be larger than the number of usable CPUs if the affinity is restricted
+    int cpu = sched_getcpu();
+    return (cpu > 0) ? (static_cast<size_t>(cpu) % getPluginCoreNum()) : 0;
+#else
+    return 0;
+#endif
+}
+
+} // namespace detail
+
+/**
+ * @brief Plugin information structure for unified registry
+ *
+ * @note  The name and the dependencies are allocated by `Allocator`, see `PluginRegistry`
+ */
+template <typename T, typename Allocator = std::allocator<T>>
+struct PluginInfo {
+    template <typename U>
+    using RebindAlloc = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+    using String = std::basic_string<char, std::char_traits<char>, RebindAlloc<char>>;
+
+    String name;                        ///< Plugin name
+    std::type_index type_idx;           ///< Type index
+    std::shared_ptr<T> instance;        ///< Plugin instance (may be null if not created yet), see `getInstance()`
+    inplace_function<std::shared_ptr<T>()> factory; ///< Factory function to create instances
+    PluginTypeName type_name;           ///< Real type name (demangled on first use)
+    PluginNameId name_id;               ///< Interned name
+    /// Names of the plugins to create first, see `PluginRegistry::warmUp()`
+    std::vector<PluginNameId, RebindAlloc<PluginNameId>> dependencies;
+    PluginScope scope;                  ///< Which callers share an instance, `instance` is only used by `Global`
+
+    PluginInfo(
+        std::string_view n, std::type_index t, inplace_function<std::shared_ptr<T>()> f,
+        PluginNameId id = PluginNameId::Invalid, PluginScope s = PluginScope::Global
+    )
+        : name(n), type_idx(t), instance(nullptr), factory(std::move(f)), type_name(t), name_id(id), scope(s)
+        , _instance_ready(false), _core_instances(getCoreInstanceNum(s)), _thread_slots(makeThreadSlots(s))
+        , _access_epoch(0), _idle_since_ms(-1) {}
+
+    PluginInfo(
+        std::string_view n, std::type_index t, std::shared_ptr<T> inst, PluginNameId id = PluginNameId::Invalid
+    )
+        : name(n), type_idx(t), instance(inst), factory(nullptr), type_name(t), name_id(id)
+        , scope(PluginScope::Global), _instance_ready(static_cast<bool>(instance)), _access_epoch(0)
+        , _idle_since_ms(-1) {}
+
+    PluginInfo(const PluginInfo &other)
+        : name(other.name), type_idx(other.type_idx), instance(nullptr), factory(other.factory)
+        , type_name(other.type_name), name_id(other.name_id), dependencies(other.dependencies), scope(other.scope)
+        , _instance_ready(false), _core_instances(getCoreInstanceNum(scope)), _access_epoch(0), _idle_since_ms(-1)
+    {
+        copyInstances(other);
+    }
+
+    PluginInfo &operator=(const PluginInfo &other)
+    {
+        if (this != &other) {
+            name = other.name;
+            type_idx = other.type_idx;
+            factory = other.factory;
+            type_name = other.type_name;
+            name_id = other.name_id;
+            dependencies = other.dependencies;
+            scope = other.scope;
+            clearInstances();
+            _core_instances = CoreInstances(getCoreInstanceNum(scope));
+            copyInstances(other);
+        }
+        return *this;
+    }
+
+    std::string dump() const
+    {
+        return "Plugin Info:"
+               "\n\t- Name: " + std::string(name) +
+               "\n\t- Type: " + type_name.str() +
+               "\n\t- Has Factory: " + (hasFactory() ? "Yes" : "No") +
+               "\n\t- Has Instance: " + (hasInstance() ? "Yes" : "No");
+    }
+
+    bool hasFactory() const
+    {
+        return static_cast<bool>(factory);
+    }
+
+    /**
+     * @brief Whether the instance has been created, for a scoped plugin whether any core or thread has one
+     */
+    bool hasInstance() const
+    {
+        if (scope == PluginScope::PerThread) {
+            return getInstanceNum() > 0;
+        }
+        return _instance_ready.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Get the instance, it is safe to call while another thread creates it
+     *
+     * @return Shared pointer to the instance (of the calling core or thread for a scoped plugin), or nullptr if it has
+     *         not been created yet
+     */
+    std::shared_ptr<T> getInstance() const
+    {
+        if (scope == PluginScope::Global) {
+            return hasInstance() ? instance : nullptr;
+        }
+        if (scope == PluginScope::PerCore) {
+            const auto &slot = _core_instances[detail::getPluginCoreId()];
+            return slot.ready.load(std::memory_order_acquire) ? slot.instance : nullptr;
+        }
+
+        auto slot = findThreadSlot();
+        return (slot != nullptr) ? readThreadSlot(*slot) : nullptr;
+    }
+
+private:
+    friend class PluginRegistry<T, Allocator>;
+
+    struct ThreadSlot;
+    struct ThreadSlots;
+    struct ThreadCache;
+
+    // The instance is written once, then published by this flag, so readers don't need a lock
+    void setInstance(std::shared_ptr<T> inst)
+    {
+        instance = std::move(inst);
+        _instance_ready.store(static_cast<bool>(instance), std::memory_order_release);
+    }
+
+    // Only the first caller runs the factory, the concurrent ones wait on this plugin only. If the factory fails,
+    // the next caller tries again
+    std::shared_ptr<T> createInstance()
+    {
+        std::lock_guard<std::mutex> lock(_instance_mutex);
+        if (!hasInstance()) {
+            setInstance(reviveOrCreate(_evicted_instance));
+        }
+        return instance;
+    }
+
+    // An evicted instance still used by a reader of the previous snapshot is reused, so there is never a second one
+    std::shared_ptr<T> reviveOrCreate(std::weak_ptr<T> &evicted)
+    {
+        auto inst = evicted.lock();
+        evicted.reset();
+        return inst ? inst : factory();
+    }
+
+    // Same as `createInstance()` for the calling core or thread. A per-thread instance is kept in a slot shared by
+    // the entry and a `thread_local` cache, so the thread finds it without locking, `PluginRegistry::evictIdle()` can
+    // still release it, and it is released when the thread exits
+    std::shared_ptr<T> createScopedInstance(uint32_t epoch)
+    {
+        if (scope == PluginScope::PerCore) {
+            auto &slot = _core_instances[detail::getPluginCoreId()];
+            if (slot.ready.load(std::memory_order_acquire)) {
+                return slot.instance;
+            }
+
+            // The cores only wait on the factory of their own slot
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            if (!slot.ready.load(std::memory_order_relaxed)) {
+                slot.instance = reviveOrCreate(slot.evicted);
+                slot.ready.store(static_cast<bool>(slot.instance), std::memory_order_release);
+                if (slot.instance) {
+                    _instance_ready.store(true, std::memory_order_release);
+                }
+            }
+            return slot.instance;
+        }
+
+        auto slot = findThreadSlot();
+        if (slot == nullptr) {
+            slot = &addThreadSlot();
+        }
+        if (slot->access_epoch.load(std::memory_order_relaxed) != epoch) {
+            slot->access_epoch.store(epoch, std::memory_order_relaxed);
+        }
+        auto inst = readThreadSlot(*slot);
+        if (inst) {
+            return inst;
+        }
+
+        // Only this thread creates the instance of its slot, so the factory runs without any lock
+        inst = factory();
+        if (inst) {
+            std::lock_guard<std::mutex> lock(_thread_slots->mutex);
+            slot->instance = inst;
+            slot->ready.store(true, std::memory_order_release);
+        }
+        return inst;
+    }
+
+    // The slot of the calling thread, or nullptr if the thread has never looked the plugin up
+    ThreadSlot *findThreadSlot() const
+    {
+        for (const auto &cached : getThreadCache().slots) {
+            if (cached.owner == _thread_slots.get()) {
+                return cached.slot.get();
+            }
+        }
+        return nullptr;
+    }
+
+    ThreadSlot &addThreadSlot()
+    {
+        auto slot = std::allocate_shared<ThreadSlot>(RebindAlloc<ThreadSlot>());
+        {
+            std::lock_guard<std::mutex> lock(_thread_slots->mutex);
+            _thread_slots->slots.push_back(slot);
+        }
+
+        // Forget the slots of the removed plugins meanwhile
+        auto &cache = getThreadCache().slots;
+        cache.erase(std::remove_if(cache.begin(), cache.end(), [](const CachedThreadSlot & cached) {
+            return cached.keeper.expired();
+        }), cache.end());
+        cache.push_back({_thread_slots.get(), _thread_slots, slot});
+        return *slot;
+    }
+
+    // Only called by the thread of the slot. It only locks if `PluginRegistry::evictIdle()` is checking the instance
+    // meanwhile (see `releaseThreadInstances()`), or if there is no instance
+    std::shared_ptr<T> readThreadSlot(ThreadSlot &slot) const
+    {
+        std::shared_ptr<T> inst;
+        slot.reading.store(true);
+        if (slot.ready.load()) {
+            inst = slot.instance;
+        }
+        slot.reading.store(false, std::memory_order_release);
+        if (!inst) {
+            std::lock_guard<std::mutex> lock(_thread_slots->mutex);
+            if (slot.ready.load(std::memory_order_relaxed)) {
+                inst = slot.instance;
+            }
+        }
+        return inst;
+    }
+
+    // Whether an instance is referenced outside of the registry
+    bool isShared() const
+    {
+        if (scope == PluginScope::Global) {
+            return instance.use_count() > 1;
+        }
+
+        for (const auto &slot : _core_instances) {
+            std::lock_guard<std::mutex> lock(slot.mutex);
+            if (slot.instance.use_count() > 1) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Release the per-thread instances which are idle (`is_idle(access_epoch, idle_since_ms)`) and only referenced by
+    // the registry. Each one is only read by its thread, so unlike the other instances it can be released in place:
+    // `ready` is cleared before checking `reading`, while the thread sets `reading` before checking `ready`, so either
+    // the release is cancelled or the thread doesn't read the instance and waits on the mutex instead
+    template <typename IsIdle>
+    size_t releaseThreadInstances(IsIdle &&is_idle)
+    {
+        std::vector<std::shared_ptr<T>, RebindAlloc<std::shared_ptr<T>>> released;
+        std::lock_guard<std::mutex> lock(_thread_slots->mutex);
+        for (auto &slot : _thread_slots->slots) {
+            if (!slot->ready.load(std::memory_order_relaxed) ||
+                    !is_idle(slot->access_epoch.load(std::memory_order_relaxed), slot->idle_since_ms)) {
+                continue;
+            }
+            slot->ready.store(false);
+            if (slot->reading.load() || (slot->instance.use_count() > 1)) {
+                slot->ready.store(true, std::memory_order_release);
+                continue;
+            }
+            released.push_back(std::move(slot->instance));
+        }
+        return released.size();
+    }
+
+    size_t getInstanceNum() const
+    {
+        if (scope == PluginScope::Global) {
+            return hasInstance() ? 1 : 0;
+        }
+
+        if (scope == PluginScope::PerThread) {
+            std::lock_guard<std::mutex> lock(_thread_slots->mutex);
+            return std::count_if(_thread_slots->slots.begin(), _thread_slots->slots.end(), [](const auto & slot) {
+                return slot->ready.load(std::memory_order_relaxed);
+            });
+        }
+
+        size_t instance_num = 0;
+        for (const auto &slot : _core_instances) {
+            instance_num += slot.ready.load(std::memory_order_acquire) ? 1 : 0;
+        }
+        return instance_num;
+    }
+
+    // Only for an entry which is not published yet
+    void clearInstances()
+    {
+        instance = nullptr;
+        _evicted_instance.reset();
+        for (auto &slot : _core_instances) {
+            slot.instance = nullptr;
+            slot.ready.store(false, std::memory_order_relaxed);
+            slot.evicted.reset();
+        }
+        _thread_slots = makeThreadSlots(scope);
+        _instance_ready.store(false, std::memory_order_release);
+    }
+
+    // Only for an entry which is not published yet, a copy of `evicted` which replaces it in the next snapshot. The
+    // instances are only kept as weak references, until the readers of the previous snapshot are done with them
+    void evictInstances(const PluginInfo &evicted)
+    {
+        if (evicted.scope == PluginScope::Global) {
+            std::lock_guard<std::mutex> lock(evicted._instance_mutex);
+            _evicted_instance = evicted.getInstance();
+        }
+        for (size_t i = 0; i < _core_instances.size(); i++) {
+            std::lock_guard<std::mutex> lock(evicted._core_instances[i].mutex);
+            if (evicted._core_instances[i].ready.load(std::memory_order_relaxed)) {
+                _core_instances[i].evicted = evicted._core_instances[i].instance;
+            }
+        }
+    }
+
+    // Only for an entry which is not published yet, the instances are shared with `other`
+    void copyInstances(const PluginInfo &other)
+    {
+        if (scope == PluginScope::Global) {
+            setInstance(other.getInstance());
+            return;
+        }
+        if (scope == PluginScope::PerThread) {
+            _thread_slots = other._thread_slots;
+            return;
+        }
+
+        bool has_instance = false;
+        for (size_t i = 0; i < _core_instances.size(); i++) {
+            // Wait for an instance being created, so the copy doesn't create a second one
+            std::lock_guard<std::mutex> lock(other._core_instances[i].mutex);
+            if (other._core_instances[i].ready.load(std::memory_order_relaxed)) {
+                _core_instances[i].instance = other._core_instances[i].instance;
+                _core_instances[i].ready.store(true, std::memory_order_relaxed);
+                has_instance = true;
+            }
+        }
+        _instance_ready.store(has_instance, std::memory_order_release);
+    }
+
+    static size_t getCoreInstanceNum(PluginScope s)
+    {
+        return (s == PluginScope::PerCore) ? detail::getPluginCoreNum() : 0;
+    }
+
+    static std::shared_ptr<ThreadSlots> makeThreadSlots(PluginScope s)
+    {
+        return (s == PluginScope::PerThread) ? std::allocate_shared<ThreadSlots>(RebindAlloc<ThreadSlots>()) : nullptr;
+    }
+
+    static ThreadCache &getThreadCache()
+    {
+        static thread_local ThreadCache cache;
+        return cache;
+    }
+
+    // Mark the plugin as used during the current eviction epoch, it only writes once per epoch
+    void touch(uint32_t epoch)
+    {
+        if (_access_epoch.load(std::memory_order_relaxed) != epoch) {
+            _access_epoch.store(epoch, std::memory_order_relaxed);
+        }
+    }
+
+    struct CoreInstance {
+        std::shared_ptr<T> instance;
+        std::atomic<bool> ready {false};    // Publishes `instance`, same as `_instance_ready`
+        std::weak_ptr<T> evicted;           // Same as `_evicted_instance`
+        mutable std::mutex mutex;           // Held while the factory creates `instance`, same as `_instance_mutex`
+    };
+    using CoreInstances = std::vector<CoreInstance, RebindAlloc<CoreInstance>>;
+
+    // Instance of a thread, shared by the entry and the `thread_local` cache of the thread
+    struct ThreadSlot {
+        std::shared_ptr<T> instance;        // Written under `ThreadSlots::mutex`
+        std::atomic<bool> ready {false};    // Publishes `instance`
+        std::atomic<bool> reading {false};  // Set by the thread while it reads `instance` without locking
+        std::atomic<uint32_t> access_epoch {0};
+        int64_t idle_since_ms = -1;         // Same as `_idle_since_ms`
+    };
+    using ThreadSlotPtr = std::shared_ptr<ThreadSlot>;
+
+    // Slots of all threads, shared by the copies of the entry
+    struct ThreadSlots {
+        std::mutex mutex;
+        std::vector<ThreadSlotPtr, RebindAlloc<ThreadSlotPtr>> slots;  // Guarded by `mutex`
+
+        ~ThreadSlots()
+        {
+            // The slots may outlive the entry in the caches of their threads, but not the instances
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto &slot : slots) {
+                slot->ready.store(false, std::memory_order_relaxed);
+                slot->instance = nullptr;
+            }
+        }
+
+        // Called when the thread of `slot` exits
+        void remove(const ThreadSlot *slot)
+        {
+            std::shared_ptr<T> released;
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = std::find_if(slots.begin(), slots.end(), [slot](const ThreadSlotPtr & other) {
+                return other.get() == slot;
+            });
+            if (it != slots.end()) {
+                (*it)->ready.store(false, std::memory_order_relaxed);
+                released = std::move((*it)->instance);
+                slots.erase(it);
+            }
+        }
+    };
+
+    // `owner` identifies the entry without locking `keeper`, whose memory can't be reused while `keeper` refers to it
+    struct CachedThreadSlot {
+        const ThreadSlots *owner;
+        std::weak_ptr<ThreadSlots> keeper;
+        ThreadSlotPtr slot;
+    };
+
+    // Slots of the calling thread, in all entries with `PluginScope::PerThread` of the registry
+    struct ThreadCache {
+        std::vector<CachedThreadSlot, RebindAlloc<CachedThreadSlot>> slots;
+
+        ~ThreadCache()
+        {
+            for (const auto &cached : slots) {
+                auto owner = cached.keeper.lock();
+                if (owner) {
+                    owner->remove(cached.slot.get());
+                }
+            }
+        }
+    };
+
+    std::atomic<bool> _instance_ready;      // Not used by `PluginScope::PerThread`, see `hasInstance()`
+    mutable std::mutex _instance_mutex;
+    CoreInstances _core_instances;          // Only used by `PluginScope::PerCore`, indexed by core
+    std::shared_ptr<ThreadSlots> _thread_slots; // Only used by `PluginScope::PerThread`
+    std::weak_ptr<T> _evicted_instance;     // Evicted instance to reuse if still alive, guarded by `_instance_mutex`
+    std::atomic<uint32_t> _access_epoch;    // Last eviction epoch the plugin has been used in
+    int64_t _idle_since_ms;                 // Only used by `PluginRegistry::evictIdle()`, -1 if not idle
+};
+
+/**
+ * @brief Construction status of a plugin, see `PluginRegistry::warmUp()`
+ */
+enum class PluginWarmUpStatus {
+    Created,                            ///< The factory returned an instance
+    Failed,                             ///< The factory returned nullptr
+    MissingDependency,                  ///< Not created, a dependency is not registered
+    DependencyFailed,                   ///< Not created, a dependency failed to be created
+    DependencyCycle,                    ///< Not created, the plugin is in or depends on a dependency cycle
+};
+
+/**
+ * @brief Construction report of a plugin, see `PluginRegistry::warmUp()`
+ */
+struct PluginWarmUpResult {
+    std::string name;                   ///< Plugin name
+    PluginTypeName type_name;           ///< Real type name (demangled on first use)
+    int64_t duration_us;                ///< Time spent in the factory, or waiting for another caller running it
+    bool success;                       ///< Whether the factory returned an instance
+    PluginWarmUpStatus status;          ///< Construction status
+};
+
+namespace detail {
+
+/**
+ * @brief Iterator over the plugins of a registry view, it dereferences to `const Info &`
+ *
+ * @note  The iterators of `PluginRegistry::begin()` and `PluginRegistry::findIf()` own their view, so the snapshot
+ *        stays alive while any copy exists. The iterators of a `View` only refer to it. A default constructed
+ *        iterator is the end of any view, see `PluginRegistry::end()`
+ */
+template <typename Info, typename View>
+class PluginInfoIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = Info;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Info *;
+    using reference = const Info &;
+
+    PluginInfoIterator() = default;
+    PluginInfoIterator(std::shared_ptr<const View> view, size_t index)
+        : _view(std::move(view)), _index(index) {}
+
+    reference operator*() const
+    {
+        return (*_view)[_index];
+    }
+
+    pointer operator->() const
+    {
+        return &(*_view)[_index];
+    }
+
+    reference operator[](difference_type n) const
+    {
+        return (*_view)[_index + n];
+    }
+
+    PluginInfoIterator &operator++()
+    {
+        ++_index;
+        return *this;
+    }
+
+    PluginInfoIterator operator++(int)
+    {
+        auto it = *this;
+        ++_index;
+        return it;
+    }
+
+    PluginInfoIterator &operator--()
+    {
+        --_index;
+        return *this;
+    }
+
+    PluginInfoIterator operator--(int)
+    {
+        auto it = *this;
+        --_index;
+        return it;
+    }
+
+    PluginInfoIterator &operator+=(difference_type n)
+    {
+        _index += n;
+        return *this;
+    }
+
+    PluginInfoIterator &operator-=(difference_type n)
+    {
+        _index -= n;
+        return *this;
+    }
+
+    PluginInfoIterator operator+(difference_type n) const
+    {
+        return PluginInfoIterator(_view, _index + n);
+    }
+
+    PluginInfoIterator operator-(difference_type n) const
+    {
+        return PluginInfoIterator(_view, _index - n);
+    }
+
+    difference_type operator-(const PluginInfoIterator &other) const
+    {
+        return static_cast<difference_type>(position(other)) - static_cast<difference_type>(other.position(*this));
+    }
+
+    // Iterators of different views are only equal if both are at the end
+    bool operator==(const PluginInfoIterator &other) const
+    {
+        if (_view.get() == other._view.get()) {
+            return _index == other._index;
+        }
+        return atEnd() && other.atEnd();
+    }
+
+    bool operator!=(const PluginInfoIterator &other) const
+    {
+        return !(*this == other);
+    }
+
+    bool operator<(const PluginInfoIterator &other) const
+    {
+        return (*this - other) < 0;
+    }
+
+private:
+    bool atEnd() const
+    {
+        return !_view || (_index >= _view->size());
+    }
+
+    // The end iterator without a view is at the end of the view of `other`
+    size_t position(const PluginInfoIterator &other) const
+    {
+        if (_view) {
+            return _index;
+        }
+        return other._view ? other._view->size() : 0;
+    }
+
+    std::shared_ptr<const View> _view;
+    size_t _index = 0;
+};
+
+/**
+ * @brief Iterator over the plugins of a name in a registry snapshot, it dereferences to `const Info &`
+ */
+template <typename Info>
+class PluginSlotIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Info;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Info *;
+    using reference = const Info &;
+
+    PluginSlotIterator() = default;
+    PluginSlotIterator(const size_t *slot, const std::shared_ptr<Info> *plugins)
+        : _slot(slot), _plugins(plugins) {}
+
+    reference operator*() const
+    {
+        return *_plugins[*_slot];
+    }
+
+    pointer operator->() const
+    {
+        return _plugins[*_slot].get();
+    }
+
+    PluginSlotIterator &operator++()
+    {
+        ++_slot;
+        return *this;
+    }
+
+    PluginSlotIterator operator++(int)
+    {
+        auto it = *this;
+        ++_slot;
+        return it;
+    }
+
+    bool operator==(const PluginSlotIterator &other) const
+    {
+        return _slot == other._slot;
+    }
+
+    bool operator!=(const PluginSlotIterator &other) const
+    {
+        return _slot != other._slot;
+    }
+
+private:
+    const size_t *_slot = nullptr;
+    const std::shared_ptr<Info> *_plugins = nullptr;
+};
+
+} // namespace detail
+
+/**
+ * @brief Compile-time plugin descriptor, see `ESP_UTILS_DEFINE_STATIC_PLUGINS()`
+ */
+template <typename T>
+struct PluginDescriptor {
+    std::string_view name;                  ///< Plugin name, it must have static storage duration
+    const std::type_info *type;             ///< Plugin type
+    std::shared_ptr<T> (*create)();         ///< Function to create the instance
+    PluginScope scope;                      ///< Which callers share an instance
+};
+
+/**
+ * @brief Table of compile-time plugin descriptors
+ */
+template <typename T>
+struct PluginDescriptorTable {
+    const PluginDescriptor<T> *descriptors = nullptr;
+    size_t size = 0;
+};
+
+/**
+ * @brief Compile-time plugin table of a registry, a registry has none unless the trait is specialized by
+ *        `ESP_UTILS_DECLARE_STATIC_PLUGINS()`
+ */
+template <typename T>
+struct PluginStaticTable {
+    static PluginDescriptorTable<T> get()
+    {
+        return {};
+    }
+};
+
+namespace detail {
+
+template <typename T, typename PluginType>
+std::shared_ptr<T> createStaticPlugin()
+{
+    return std::make_shared<PluginType>();
+}
+
+} // namespace detail
+
+/**
+ * @brief Make a compile-time plugin descriptor
+ *
+ * @tparam T Base class type for plugins
+ * @tparam PluginType Plugin type, it is default constructed unless `create` is given
+ * @param[in] name Plugin name, it must have static storage duration (e.g. a string literal)
+ * @param[in] create Function to create the instance (optional)
+ * @return Plugin descriptor
+ */
+template <typename T, typename PluginType>
+constexpr PluginDescriptor<T> makeStaticPlugin(
+    std::string_view name, std::shared_ptr<T> (*create)() = &detail::createStaticPlugin<T, PluginType>
+)
+{
+    static_assert(std::is_base_of_v<T, PluginType>, "PluginType must inherit from base type T");
+
+    return {name, &typeid(PluginType), create, PluginScope::Global};
+}
+
+/**
+ * @brief Make a compile-time plugin descriptor with instance scope, see `PluginRegistry::registerPlugin()`
+ *
+ * @tparam T Base class type for plugins
+ * @tparam PluginType Plugin type, it is default constructed unless `create` is given
+ * @param[in] name Plugin name, it must have static storage duration (e.g. a string literal)
+ * @param[in] scope Which callers share an instance
+ * @param[in] create Function to create the instance (optional)
+ * @return Plugin descriptor
+ */
+template <typename T, typename PluginType>
+constexpr PluginDescriptor<T> makeStaticPlugin(
+    std::string_view name, PluginScope scope,
+    std::shared_ptr<T> (*create)() = &detail::createStaticPlugin<T, PluginType>
+)
+{
+    static_assert(std::is_base_of_v<T, PluginType>, "PluginType must inherit from base type T");
+
+    return {name, &typeid(PluginType), create, scope};
+}
+
+/**
+ * @brief Plugin registration and management class
+ * Uses unified vector-based storage for all plugin information, indexed by type and by interned name.
+ *
+ * The storage is published as immutable snapshots: writers copy the current snapshot, modify the copy and swap it
+ * in, so lookups and iterations never take a lock. A replaced snapshot is released once all the readers which may
+ * have loaded it are done, see `ReadGuard`. Until the first lookup, registrations modify the snapshot in place
+ * instead, so registering plugins from static constructors doesn't copy the registry each time.
+ *
+ * The plugins of the table defined by `ESP_UTILS_DEFINE_STATIC_PLUGINS()` are loaded on the first use of the
+ * registry, before any other plugin.
+ *
+ * All the storage of the registry (snapshots, plugin entries, names and indexes) is allocated by `Allocator`, so a
+ * registry can be kept in PSRAM by `esp_utils::GeneralMemoryAllocator`, e.g.
+ * `PluginRegistry<Base, GeneralMemoryAllocator<Base>>`. Each allocator type makes a separate registry.
+ *
+ * @note  `Allocator` must be default constructible and stateless. The plugin instances are not allocated by it, they
+ *        are created by the factories
+ *
+ * @tparam T Base class type for plugins
+ * @tparam Allocator Allocator of the internal storage (optional)
+ */
+template <typename T, typename Allocator>
+class PluginRegistry {
+public:
+    using InstancePtr = std::shared_ptr<T>;
+    using FactoryFunc = inplace_function<InstancePtr()>;
+    using PluginInfoType = PluginInfo<T, Allocator>;
+
+private:
+    template <typename U>
+    using RebindAlloc = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+    template <typename U>
+    using Vector = std::vector<U, RebindAlloc<U>>;
+    template <typename K, typename V>
+    using Map = std::unordered_map<K, V, std::hash<K>, std::equal_to<K>, RebindAlloc<std::pair<const K, V>>>;
+    using String = typename PluginInfoType::String;
+    using PluginInfoPtr = std::shared_ptr<PluginInfoType>;
+
+    /**
+     * @brief Immutable view of the registry, the plugin entries are shared between snapshots
+     */
+    struct Snapshot {
+        Vector<PluginInfoPtr> plugins;
+        Map<std::type_index, size_t> type_index;            // Slot of the first plugin of each type
+        Map<std::string_view, PluginNameId> name_ids;       // Keys point into `names`
+        Vector<std::string_view> names;                     // Indexed by ID
+        Vector<Vector<size_t>> name_slots;                  // Indexed by ID, in registration order
+    };
+
+    struct SnapshotDeleter {
+        void operator()(Snapshot *snapshot) const
+        {
+            RebindAlloc<Snapshot> alloc;
+            std::allocator_traits<RebindAlloc<Snapshot>>::destroy(alloc, snapshot);
+            std::allocator_traits<RebindAlloc<Snapshot>>::deallocate(alloc, snapshot, 1);
+        }
+    };
+    using SnapshotPtr = std::unique_ptr<Snapshot, SnapshotDeleter>;
+
+    template <typename... Args>
+    static SnapshotPtr makeSnapshot(Args &&... args)
+    {
+        RebindAlloc<Snapshot> alloc;
+        Snapshot *snapshot = std::allocator_traits<RebindAlloc<Snapshot>>::allocate(alloc, 1);
+        std::allocator_traits<RebindAlloc<Snapshot>>::construct(alloc, snapshot, std::forward<Args>(args)...);
+        return SnapshotPtr(snapshot);
+    }
+
+    template <typename... Args>
+    static PluginInfoPtr makePluginInfo(Args &&... args)
+    {
+        return std::allocate_shared<PluginInfoType>(RebindAlloc<PluginInfoType>(), std::forward<Args>(args)...);
+    }
+
+    // Factories other than `FactoryFunc` itself, which is taken by the non-template overloads (e.g. for `nullptr`)
+    template <typename F>
+    using EnableIfFactory = std::enable_if_t<
+        !std::is_same_v<std::decay_t<F>, FactoryFunc> && std::is_invocable_r_v<InstancePtr, std::decay_t<F> &>
+    >;
+
+    // The factory is stored inline, only a `std::function` passed by the caller keeps its captures on the heap. An
+    // empty `std::function` makes an empty factory
+    template <typename F>
+    static FactoryFunc makeFactory(F &&factory)
+    {
+        static_assert(
+            FactoryFunc::template fits<std::decay_t<F>>,
+            "Factory doesn't fit in the inline storage, pass it as a `std::function` to store it on the heap"
+        );
+        return FactoryFunc(std::forward<F>(factory));
+    }
+
+    struct RetiredSnapshot {
+        SnapshotPtr snapshot;
+        uint32_t epoch;                                     // `State::reclaim_count` when it has been replaced
+    };
+
+    struct State {
+        std::atomic<Snapshot *> current;
+        std::atomic<uint32_t> readers[3];                   // Active readers, by reclamation epoch
+        std::atomic<uint32_t> reclaim_epoch;                // 0 to 2, only advanced by the writers
+        uint32_t reclaim_count;                             // Number of advances of `reclaim_epoch`
+        std::atomic<size_t> retired_num;
+        std::atomic<bool> has_readers;                      // Whether a lookup has been done, see `editLocked()`
+        std::atomic<uint32_t> generation;                   // Bumped by each modification
+        std::atomic<uint32_t> access_epoch;                 // Bumped by each `evictIdle()`
+        int64_t epoch_start_ms;                             // When the current access epoch started
+        std::recursive_mutex mutex;                         // Serializes the writers
+        Snapshot *batch;                                    // Snapshot modified by `registerBatch()`, if any
+        Vector<RetiredSnapshot> retired;                    // Replaced snapshots which may still be read, in order
+        std::forward_list<String, RebindAlloc<String>> names; // Stable storage of the interned names
+
+        State()
+            : current(loadStaticPlugins().release()), readers{}, reclaim_epoch(0), reclaim_count(0)
+            , retired_num(0)
+            , has_readers(false), generation(1), access_epoch(1), epoch_start_ms(getTimeMs())
+            , batch(nullptr) {}
+
+        ~State()
+        {
+            SnapshotDeleter()(current.load(std::memory_order_relaxed));
+        }
+    };
+
+    static State &getState()
+    {
+        static State state;
+        return state;
+    }
+
+    /**
+     * @brief Keep the current snapshot alive while it is read. The reader is counted in the reclamation epoch it
+     *        started in, a snapshot replaced in epoch N is released once the epoch has advanced twice, which needs the
+     *        readers of epochs N - 1 and N to be done. The readers starting meanwhile are counted in the new epochs,
+     *        so continuous lookups don't delay the release
+     */
+    class ReadGuard {
+    public:
+        ReadGuard()
+            : _state(getState())
+        {
+            if (!_state.has_readers.load(std::memory_order_acquire)) {
+                // Wait for the writers which modify the snapshot in place, the next ones will copy it
+                std::lock_guard<std::recursive_mutex> lock(_state.mutex);
+                _state.has_readers.store(true, std::memory_order_release);
+            }
+            // Sequentially consistent with `reclaimLocked()`: once the epoch is checked again, the writer either sees
+            // this reader, or has not advanced the epoch yet
+            while (true) {
+                _epoch = _state.reclaim_epoch.load(std::memory_order_seq_cst);
+                _state.readers[_epoch].fetch_add(1, std::memory_order_seq_cst);
+                if (_state.reclaim_epoch.load(std::memory_order_seq_cst) == _epoch) {
+                    break;
+                }
+                _state.readers[_epoch].fetch_sub(1, std::memory_order_release);
+            }
+            _snapshot = _state.current.load(std::memory_order_seq_cst);
+        }
+
+        ~ReadGuard()
+        {
+            // The last reader of an epoch may allow to release the retired snapshots
+            if ((_state.readers[_epoch].fetch_sub(1, std::memory_order_seq_cst) == 1) &&
+                    (_state.retired_num.load(std::memory_order_relaxed) != 0)) {
+                std::unique_lock<std::recursive_mutex> lock(_state.mutex, std::try_to_lock);
+                if (lock.owns_lock()) {
+                    reclaimLocked();
+                }
+            }
+        }
+
+        ReadGuard(const ReadGuard &) = delete;
+        ReadGuard &operator=(const ReadGuard &) = delete;
+
+        const Snapshot &operator*() const
+        {
+            return *_snapshot;
+        }
+
+        const Snapshot *operator->() const
+        {
+            return _snapshot;
+        }
+
+    private:
+        State &_state;
+        const Snapshot *_snapshot;
+        uint32_t _epoch;
+    };
+
+    static const Snapshot &currentLocked()
+    {
+        return *getState().current.load(std::memory_order_relaxed);
+    }
+
+    // The snapshot of `registerBatch()` if any, the current one otherwise
+    static const Snapshot &pendingLocked()
+    {
+        auto &state = getState();
+        return (state.batch != nullptr) ? *state.batch : currentLocked();
+    }
 
-namespace esp_utils {
+    /**
+     * @brief Get the snapshot to modify: the one of `registerBatch()`, the current one as long as no lookup has been
+     *        done (e.g. registrations from static constructors), otherwise a copy, which is stored in `next`. See
+     *        `commitLocked()`
+     */
+    static Snapshot &editLocked(SnapshotPtr &next)
+    {
+        auto &state = getState();
+        if (state.batch != nullptr) {
+            return *state.batch;
+        }
+        if (!state.has_readers.load(std::memory_order_relaxed)) {
+            return *state.current.load(std::memory_order_relaxed);
+        }
+        next = makeSnapshot(currentLocked());
+        return *next;
+    }
 
-/**
- * @brief Plugin information structure for unified registry
- */
-template <typename T>
-struct PluginInfo {
-    std::string name;                    ///< Plugin name
-    std::type_index type_idx;           ///< Type index
-    std::shared_ptr<T> instance;        ///< Plugin instance (may be null if not created yet)
-    std::function<std::shared_ptr<T>()> factory; ///< Factory function to create instances
-    std::string type_name;              ///< Real type name (demangled)
+    // `plugins_changed` is false if only names have been interned, which doesn't invalidate the `PluginHandle`s
+    static void commitLocked(SnapshotPtr next, bool plugins_changed = true)
+    {
+        auto &state = getState();
+        if (next) {
+            publishLocked(std::move(next), plugins_changed);
+        } else if ((state.batch == nullptr) && plugins_changed) {
+            state.generation.fetch_add(1, std::memory_order_release);
+        }
+    }
 
-    PluginInfo(const std::string &n, std::type_index t, std::function<std::shared_ptr<T>()> f, const std::string &tn)
-        : name(n), type_idx(t), instance(nullptr), factory(std::move(f)), type_name(tn) {}
+    static void publishLocked(SnapshotPtr next, bool plugins_changed = true)
+    {
+        auto &state = getState();
 
-    PluginInfo(const std::string &n, std::type_index t, std::shared_ptr<T> inst, const std::string &tn)
-        : name(n), type_idx(t), instance(inst), factory(nullptr), type_name(tn) {}
+        SnapshotPtr replaced(state.current.exchange(next.release(), std::memory_order_seq_cst));
+        state.retired.push_back({std::move(replaced), state.reclaim_count});
+        state.retired_num.store(state.retired.size(), std::memory_order_relaxed);
+        if (plugins_changed) {
+            state.generation.fetch_add(1, std::memory_order_release);
+        }
+        reclaimLocked();
+    }
 
-    std::string dump() const
+    // Release the retired snapshots no reader can still use, advancing the epoch as long as the readers of the
+    // previous one are done. It never waits for the readers
+    static void reclaimLocked()
     {
-        return "Plugin Info:"
-               "\n\t- Name: " + name +
-               "\n\t- Type: " + type_name +
-               "\n\t- Has Factory: " + (hasFactory() ? "Yes" : "No") +
-               "\n\t- Has Instance: " + (hasInstance() ? "Yes" : "No");
+        auto &state = getState();
+        Vector<RetiredSnapshot> released;
+
+        while (!state.retired.empty()) {
+            auto it = state.retired.begin();
+            while ((it != state.retired.end()) && (state.reclaim_count - it->epoch >= 2)) {
+                ++it;
+            }
+            if (it != state.retired.begin()) {
+                std::move(state.retired.begin(), it, std::back_inserter(released));
+                state.retired.erase(state.retired.begin(), it);
+                continue;
+            }
+            auto epoch = state.reclaim_epoch.load(std::memory_order_relaxed);
+            if (state.readers[(epoch + 2) % 3].load(std::memory_order_seq_cst) != 0) {
+                break;
+            }
+            state.reclaim_epoch.store((epoch + 1) % 3, std::memory_order_seq_cst);
+            state.reclaim_count++;
+        }
+        state.retired_num.store(state.retired.size(), std::memory_order_relaxed);
+        // `released` is destroyed last, the destructors of the plugins may use the registry again
     }
 
-    bool hasFactory() const
+    static PluginNameId findNameId(const Snapshot &snapshot, std::string_view name)
     {
-        return static_cast<bool>(factory);
+        auto it = snapshot.name_ids.find(name);
+        return (it != snapshot.name_ids.end()) ? it->second : PluginNameId::Invalid;
     }
 
-    bool hasInstance() const
+    static const Vector<size_t> *findSlots(const Snapshot &snapshot, PluginNameId id)
     {
-        return static_cast<bool>(instance);
+        auto index = static_cast<size_t>(id);
+        return (index < snapshot.name_slots.size()) ? &snapshot.name_slots[index] : nullptr;
     }
-};
 
-/**
- * @brief Plugin registration and management class
- * Uses unified vector-based storage for all plugin information
- *
- * @tparam T Base class type for plugins
- */
-template <typename T>
-class PluginRegistry {
-public:
-    using InstancePtr = std::shared_ptr<T>;
-    using FactoryFunc = std::function<InstancePtr()>;
-    using PluginInfoType = PluginInfo<T>;
+    // A static name is referenced as it is, other names are copied into `State::names`
+    static PluginNameId internNameLocked(Snapshot &snapshot, std::string_view name, bool is_static = false)
+    {
+        auto id = findNameId(snapshot, name);
+        if (id != PluginNameId::Invalid) {
+            return id;
+        }
 
-private:
-    static std::vector<PluginInfoType> &getPlugins()
+        id = static_cast<PluginNameId>(snapshot.names.size());
+        if (is_static) {
+            snapshot.names.push_back(name);
+        } else {
+            auto &names = getState().names;
+            names.emplace_front(name);
+            snapshot.names.emplace_back(names.front());
+        }
+        snapshot.name_ids.emplace(snapshot.names.back(), id);
+        snapshot.name_slots.emplace_back();
+        return id;
+    }
+
+    static void rebuildIndexes(Snapshot &snapshot)
+    {
+        snapshot.type_index.clear();
+        for (auto &slots : snapshot.name_slots) {
+            slots.clear();
+        }
+        for (size_t i = 0; i < snapshot.plugins.size(); i++) {
+            snapshot.type_index.emplace(snapshot.plugins[i]->type_idx, i);
+            snapshot.name_slots[static_cast<size_t>(snapshot.plugins[i]->name_id)].push_back(i);
+        }
+    }
+
+    static void addPlugin(Snapshot &snapshot, PluginInfoPtr plugin)
+    {
+        auto slot = snapshot.plugins.size();
+
+        // Keep the first plugin of a type, same as a linear scan
+        snapshot.type_index.emplace(plugin->type_idx, slot);
+        snapshot.name_slots[static_cast<size_t>(plugin->name_id)].push_back(slot);
+        snapshot.plugins.push_back(std::move(plugin));
+    }
+
+    // Called once while `State` is constructed, so it must not use `getState()`
+    static SnapshotPtr loadStaticPlugins()
+    {
+        // The declaration of the table is next to the base type, so it is seen wherever the type is complete
+        static_assert(sizeof(T) > 0, "The base type must be complete, see `ESP_UTILS_DECLARE_STATIC_PLUGINS()`");
+
+        auto snapshot = makeSnapshot();
+        auto table = PluginStaticTable<T>::get();
+        snapshot->plugins.reserve(table.size);
+        for (size_t i = 0; i < table.size; i++) {
+            const auto &descriptor = table.descriptors[i];
+            auto type_key = std::type_index(*descriptor.type);
+            auto id = internNameLocked(*snapshot, descriptor.name, true);
+
+            bool duplicated = false;
+            for (auto slot : snapshot->name_slots[static_cast<size_t>(id)]) {
+                duplicated = duplicated || (snapshot->plugins[slot]->type_idx == type_key);
+            }
+            if (!duplicated) {
+                addPlugin(*snapshot, makePluginInfo(
+                              descriptor.name, type_key, FactoryFunc(descriptor.create), id, descriptor.scope
+                          ));
+            }
+        }
+
+        return snapshot;
+    }
+
+    /**
+     * @brief Remove the plugins matching `pred` and publish the result, nothing is published if none matches
+     */
+    template<typename Predicate>
+    static size_t removeLocked(Predicate pred, size_t max_count = SIZE_MAX)
+    {
+        const auto &current = currentLocked();
+        SnapshotPtr next;
+
+        size_t removed_count = 0;
+        for (size_t i = 0; (i < current.plugins.size()) && (removed_count < max_count); i++) {
+            if (!pred(*current.plugins[i])) {
+                continue;
+            }
+            if (!next) {
+                next = makeSnapshot(current);
+                // Keep the plugins before the first match
+                next->plugins.resize(i);
+            }
+            ++removed_count;
+        }
+        if (!next) {
+            return 0;
+        }
+
+        // Copy the remaining plugins
+        removed_count = 0;
+        for (size_t i = next->plugins.size(); i < current.plugins.size(); i++) {
+            if ((removed_count < max_count) && pred(*current.plugins[i])) {
+                ++removed_count;
+                continue;
+            }
+            next->plugins.push_back(current.plugins[i]);
+        }
+        rebuildIndexes(*next);
+        publishLocked(std::move(next));
+
+        return removed_count;
+    }
+
+    static int64_t getTimeMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()
+               ).count();
+    }
+
+    static InstancePtr getInstance(const PluginInfoPtr &plugin)
+    {
+        auto epoch = getState().access_epoch.load(std::memory_order_relaxed);
+        plugin->touch(epoch);
+        if (plugin->scope != PluginScope::Global) {
+            return plugin->factory ? plugin->createScopedInstance(epoch) : nullptr;
+        }
+
+        auto instance = plugin->getInstance();
+        if (instance || !plugin->factory) {
+            return instance;
+        }
+
+        // Slow path, the factory runs outside the registry lock, so it can be slow or use other registries
+        return plugin->createInstance();
+    }
+
+    static InstancePtr get(const Snapshot &snapshot, PluginNameId id)
+    {
+        auto slots = findSlots(snapshot, id);
+        if ((slots == nullptr) || slots->empty()) {
+            return nullptr;
+        }
+        return getInstance(snapshot.plugins[slots->front()]);
+    }
+
+    static std::vector<InstancePtr> getAll(const Snapshot &snapshot, PluginNameId id)
+    {
+        std::vector<InstancePtr> instances;
+        auto slots = findSlots(snapshot, id);
+        if (slots == nullptr) {
+            return instances;
+        }
+
+        instances.reserve(slots->size());
+        for (auto slot : *slots) {
+            auto instance = getInstance(snapshot.plugins[slot]);
+            if (instance) {
+                instances.push_back(std::move(instance));
+            }
+        }
+        return instances;
+    }
+
+    static bool needsCreation(const PluginInfoType &plugin)
+    {
+        return (plugin.scope == PluginScope::Global) && plugin.hasFactory() && !plugin.hasInstance();
+    }
+
+    struct WarmUpNode {
+        size_t slot;
+        std::vector<size_t> dependents;     // Nodes waiting for this one
+        size_t waiting = 0;                 // Dependencies not created yet
+        PluginWarmUpResult result {};
+    };
+
+    /**
+     * @brief Build the dependency graph of the plugins matching `pred` and of their dependencies, then create them
+     *        in dependency order, the independent ones in parallel
+     */
+    template<typename Predicate>
+    static std::vector<PluginWarmUpResult> warmUp(const Snapshot &snapshot, Predicate &pred, size_t thread_num)
     {
-        static std::vector<PluginInfoType> plugins;
-        return plugins;
+        // Collect the selected plugins and, transitively, the dependencies they need
+        std::vector<size_t> node_of(snapshot.plugins.size(), SIZE_MAX);
+        std::vector<size_t> slots;
+        for (size_t slot = 0; slot < snapshot.plugins.size(); slot++) {
+            if (needsCreation(*snapshot.plugins[slot]) && pred(*snapshot.plugins[slot])) {
+                node_of[slot] = 0;
+                slots.push_back(slot);
+            }
+        }
+        for (size_t i = 0; i < slots.size(); i++) {
+            for (auto id : snapshot.plugins[slots[i]]->dependencies) {
+                auto dependency_slots = findSlots(snapshot, id);
+                for (size_t j = 0; (dependency_slots != nullptr) && (j < dependency_slots->size()); j++) {
+                    auto slot = (*dependency_slots)[j];
+                    if ((node_of[slot] == SIZE_MAX) && needsCreation(*snapshot.plugins[slot])) {
+                        node_of[slot] = 0;
+                        slots.push_back(slot);
+                    }
+                }
+            }
+        }
+        std::sort(slots.begin(), slots.end());
+
+        std::vector<WarmUpNode> nodes(slots.size());
+        for (size_t i = 0; i < slots.size(); i++) {
+            const auto &plugin = *snapshot.plugins[slots[i]];
+            node_of[slots[i]] = i;
+            nodes[i].slot = slots[i];
+            nodes[i].result = {std::string(plugin.name), plugin.type_name, 0, false, PluginWarmUpStatus::Created};
+        }
+        for (size_t i = 0; i < nodes.size(); i++) {
+            for (auto id : snapshot.plugins[nodes[i].slot]->dependencies) {
+                auto dependency_slots = findSlots(snapshot, id);
+                if ((dependency_slots == nullptr) || dependency_slots->empty()) {
+                    nodes[i].result.status = PluginWarmUpStatus::MissingDependency;
+                    continue;
+                }
+                for (auto slot : *dependency_slots) {
+                    // Plugins which already have an instance are not in the graph
+                    if (node_of[slot] != SIZE_MAX) {
+                        nodes[node_of[slot]].dependents.push_back(i);
+                        nodes[i].waiting++;
+                    }
+                }
+            }
+        }
+
+        // Find the cycles, the nodes never released by a topological sort are in or after a cycle
+        std::vector<size_t> ready;
+        {
+            std::vector<size_t> waiting(nodes.size());
+            for (size_t i = 0; i < nodes.size(); i++) {
+                waiting[i] = nodes[i].waiting;
+                if (waiting[i] == 0) {
+                    ready.push_back(i);
+                }
+            }
+            for (size_t i = 0; i < ready.size(); i++) {
+                for (auto dependent : nodes[ready[i]].dependents) {
+                    if (--waiting[dependent] == 0) {
+                        ready.push_back(dependent);
+                    }
+                }
+            }
+            for (size_t i = 0; i < nodes.size(); i++) {
+                if (waiting[i] != 0) {
+                    nodes[i].result.status = PluginWarmUpStatus::DependencyCycle;
+                }
+            }
+            ready.erase(std::remove_if(ready.begin(), ready.end(), [&nodes](size_t i) {
+                return nodes[i].waiting != 0;
+            }), ready.end());
+        }
+
+        std::mutex mutex;
+        std::condition_variable cv;
+        size_t remaining = std::count_if(nodes.begin(), nodes.end(), [](const WarmUpNode & node) {
+            return node.result.status != PluginWarmUpStatus::DependencyCycle;
+        });
+        auto worker = [&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                cv.wait(lock, [&]() {
+                    return !ready.empty() || (remaining == 0);
+                });
+                if (ready.empty()) {
+                    return;
+                }
+                auto &node = nodes[ready.back()];
+                ready.pop_back();
+
+                // A node which can't be created is only released to its dependents
+                if (node.result.status == PluginWarmUpStatus::Created) {
+                    lock.unlock();
+                    auto start = std::chrono::steady_clock::now();
+                    node.result.success = static_cast<bool>(getInstance(snapshot.plugins[node.slot]));
+                    auto duration = std::chrono::steady_clock::now() - start;
+                    node.result.duration_us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+                    node.result.status = node.result.success ? PluginWarmUpStatus::Created : PluginWarmUpStatus::Failed;
+                    lock.lock();
+                }
+                for (auto i : node.dependents) {
+                    auto &dependent = nodes[i];
+                    if (!node.result.success && (dependent.result.status == PluginWarmUpStatus::Created)) {
+                        dependent.result.status = PluginWarmUpStatus::DependencyFailed;
+                    }
+                    if (--dependent.waiting == 0) {
+                        ready.push_back(i);
+                    }
+                }
+                remaining--;
+                cv.notify_all();
+            }
+        };
+
+        // The caller is one of the workers
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < std::min(thread_num, nodes.size()); i++) {
+            threads.emplace_back(worker);
+        }
+        worker();
+        for (auto &thread : threads) {
+            thread.join();
+        }
+
+        std::vector<PluginWarmUpResult> results;
+        results.reserve(nodes.size());
+        for (auto &node : nodes) {
+            results.push_back(std::move(node.result));
+        }
+        return results;
     }
 
-    static std::recursive_mutex &getMutex()
+    template<typename Func>
+    static void forEachByName(const Snapshot &snapshot, PluginNameId id, Func &func)
     {
-        static std::recursive_mutex mtx;
-        return mtx;
+        auto slots = findSlots(snapshot, id);
+        if (slots == nullptr) {
+            return;
+        }
+
+        for (auto slot : *slots) {
+            func(*snapshot.plugins[slot]);
+        }
     }
 
 public:
+    class View;
+
+    /**
+     * @brief Iterator over the plugins of a snapshot, see `View` and `begin()`
+     */
+    using const_iterator = detail::PluginInfoIterator<PluginInfoType, View>;
+    using iterator = const_iterator;
+
     /**
-     * @brief Simple iterator for plugins
+     * @brief Cached typed plugin handle, see `PluginHandle`
      */
-    using iterator = typename std::vector<PluginInfoType>::iterator;
-    using const_iterator = typename std::vector<PluginInfoType>::const_iterator;
+    template <typename PluginType>
+    using Handle = PluginHandle<T, PluginType, Allocator>;
+
+    /**
+     * @brief Get the generation of the registry, it changes whenever a plugin is registered or removed
+     *
+     * @return Generation
+     */
+    static uint32_t getGeneration()
+    {
+        return getState().generation.load(std::memory_order_acquire);
+    }
 
     /**
      * @brief Get instance by type (using typeid)
@@ -99,21 +1569,8 @@ public:
     template <typename PluginType>
     static std::shared_ptr<PluginType> get()
     {
-        static_assert(std::is_base_of_v<T, PluginType>, "PluginType must inherit from base type T");
-
-        auto type_key = std::type_index(typeid(PluginType));
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
-
-        for (auto &plugin : plugins) {
-            if (plugin.type_idx == type_key) {
-                if (!plugin.instance && plugin.factory) {
-                    plugin.instance = plugin.factory();
-                }
-                return std::static_pointer_cast<PluginType>(plugin.instance);
-            }
-        }
-        return nullptr;
+        PluginScope scope = PluginScope::Global;
+        return get<PluginType>(scope);
     }
 
     /**
@@ -122,20 +1579,22 @@ public:
      * @param[in] name Plugin name to get
      * @return Shared pointer to the plugin instance (first match if multiple exist)
      */
-    static InstancePtr get(const std::string &name)
+    static InstancePtr get(std::string_view name)
     {
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
+        ReadGuard snapshot;
+        return get(*snapshot, findNameId(*snapshot, name));
+    }
 
-        for (auto &plugin : plugins) {
-            if (plugin.name == name) {
-                if (!plugin.instance && plugin.factory) {
-                    plugin.instance = plugin.factory();
-                }
-                return plugin.instance;
-            }
-        }
-        return nullptr;
+    /**
+     * @brief Get instance by interned name (returns first match)
+     *
+     * @param[in] id Interned plugin name, see `internName()`
+     * @return Shared pointer to the plugin instance (first match if multiple exist)
+     */
+    static InstancePtr get(PluginNameId id)
+    {
+        ReadGuard snapshot;
+        return get(*snapshot, id);
     }
 
     /**
@@ -144,23 +1603,73 @@ public:
      * @param[in] name Plugin name to get all instances for
      * @return Vector of shared pointers to all matching plugin instances
      */
-    static std::vector<InstancePtr> getAll(const std::string &name)
+    static std::vector<InstancePtr> getAll(std::string_view name)
     {
-        std::vector<InstancePtr> instances;
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
+        ReadGuard snapshot;
+        return getAll(*snapshot, findNameId(*snapshot, name));
+    }
 
-        for (auto &plugin : plugins) {
-            if (plugin.name == name) {
-                if (!plugin.instance && plugin.factory) {
-                    plugin.instance = plugin.factory();
-                }
-                if (plugin.instance) {
-                    instances.push_back(plugin.instance);
-                }
-            }
+    /**
+     * @brief Get all instances by interned name
+     *
+     * @param[in] id Interned plugin name, see `internName()`
+     * @return Vector of shared pointers to all matching plugin instances
+     */
+    static std::vector<InstancePtr> getAll(PluginNameId id)
+    {
+        ReadGuard snapshot;
+        return getAll(*snapshot, id);
+    }
+
+    /**
+     * @brief Intern a plugin name, so hot paths can look it up by ID without hashing the string again
+     *
+     * @note  Registration interns the name as well, the ID of a name never changes, even if its plugins are removed
+     *
+     * @param[in] name Plugin name
+     * @return ID of the name
+     */
+    static PluginNameId internName(std::string_view name)
+    {
+        auto id = findNameId(name);
+        if (id != PluginNameId::Invalid) {
+            return id;
         }
-        return instances;
+
+        std::lock_guard<std::recursive_mutex> lock(getState().mutex);
+        id = findNameId(pendingLocked(), name);
+        if (id == PluginNameId::Invalid) {
+            SnapshotPtr next;
+            id = internNameLocked(editLocked(next), name);
+            commitLocked(std::move(next), false);
+        }
+        return id;
+    }
+
+    /**
+     * @brief Find the ID of an interned plugin name, without interning it
+     *
+     * @param[in] name Plugin name
+     * @return ID of the name, or `PluginNameId::Invalid` if it has never been interned
+     */
+    static PluginNameId findNameId(std::string_view name)
+    {
+        ReadGuard snapshot;
+        return findNameId(*snapshot, name);
+    }
+
+    /**
+     * @brief Get the name of an interned ID
+     *
+     * @param[in] id Interned plugin name
+     * @return Name, or an empty string if the ID is invalid. It stays valid as long as the program runs
+     */
+    static std::string_view getName(PluginNameId id)
+    {
+        ReadGuard snapshot;
+        auto index = static_cast<size_t>(id);
+
+        return (index < snapshot->names.size()) ? snapshot->names[index] : std::string_view();
     }
 
     /**
@@ -171,84 +1680,228 @@ public:
     static std::vector<std::string> listRegisteredNames()
     {
         std::vector<std::string> names;
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
+        ReadGuard snapshot;
+        std::vector<bool> listed(snapshot->names.size(), false);
+
+        for (const auto &plugin : snapshot->plugins) {
+            auto index = static_cast<size_t>(plugin->name_id);
+            if (!listed[index]) {
+                listed[index] = true;
+                names.emplace_back(plugin->name);
+            }
+        }
+        return names;
+    }
+
+    /**
+     * @brief Get count of plugins registered with each name
+     *
+     * @return Unordered map with plugin names as keys and count as values
+     */
+    static std::unordered_map<std::string, size_t> getNameCounts()
+    {
+        std::unordered_map<std::string, size_t> counts;
+        ReadGuard snapshot;
+
+        for (const auto &plugin : snapshot->plugins) {
+            counts[std::string(plugin->name)]++;
+        }
+        return counts;
+    }
+
+    /**
+     * @brief Read-only view of the registry, which can be iterated without copying the plugins or taking any lock
+     *
+     * @note  The view keeps its snapshot alive, so it is not affected by later modifications of the registry, and
+     *        its iterators stay valid as long as it exists. It delays the release of replaced snapshots, so it should
+     *        not be kept for long
+     */
+    class View {
+    public:
+        /**
+         * @brief Plugins of one name, in registration order
+         */
+        class NameRange {
+        public:
+            using const_iterator = detail::PluginSlotIterator<PluginInfoType>;
+
+            const_iterator begin() const
+            {
+                return const_iterator(_slots.data(), _plugins);
+            }
+
+            const_iterator end() const
+            {
+                return const_iterator(_slots.data() + _slots.size(), _plugins);
+            }
+
+            size_t size() const
+            {
+                return _slots.size();
+            }
+
+            bool empty() const
+            {
+                return _slots.empty();
+            }
+
+        private:
+            friend class View;
+
+            NameRange(const Vector<size_t> &slots, const std::shared_ptr<PluginInfoType> *plugins)
+                : _slots(slots), _plugins(plugins) {}
+
+            const Vector<size_t> &_slots;
+            const std::shared_ptr<PluginInfoType> *_plugins;
+        };
+
+        View(const View &) = delete;
+        View &operator=(const View &) = delete;
+
+        const_iterator begin() const
+        {
+            return const_iterator(refer(), 0);
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(refer(), size());
+        }
+
+        size_t size() const
+        {
+            return _snapshot->plugins.size();
+        }
+
+        bool empty() const
+        {
+            return _snapshot->plugins.empty();
+        }
+
+        const PluginInfoType &operator[](size_t index) const
+        {
+            return *_snapshot->plugins[index];
+        }
+
+        /**
+         * @brief Get the plugins with a name
+         *
+         * @param[in] name Plugin name
+         * @return Range of the matching plugins, it is valid as long as the view exists
+         */
+        NameRange byName(std::string_view name) const
+        {
+            return byName(findNameId(*_snapshot, name));
+        }
 
-        for (const auto &plugin : plugins) {
-            if (std::find(names.begin(), names.end(), plugin.name) == names.end()) {
-                names.push_back(plugin.name);
-            }
+        /**
+         * @brief Get the plugins with an interned name
+         *
+         * @param[in] id Interned plugin name, see `internName()`
+         * @return Range of the matching plugins, it is valid as long as the view exists
+         */
+        NameRange byName(PluginNameId id) const
+        {
+            static const Vector<size_t> no_slots;
+            auto slots = findSlots(*_snapshot, id);
+            return NameRange((slots != nullptr) ? *slots : no_slots, _snapshot->plugins.data());
         }
-        return names;
-    }
+
+        /**
+         * @brief Find plugin by predicate
+         *
+         * @param[in] pred Predicate function that returns true for matching plugin
+         * @return const_iterator pointing to first matching plugin, or end() if not found
+         */
+        template<typename Predicate>
+        const_iterator findIf(Predicate pred) const
+        {
+            return std::find_if(begin(), end(), pred);
+        }
+
+    private:
+        friend class PluginRegistry;
+
+        View() = default;
+
+        // Non-owning, the iterators of a view don't count references
+        std::shared_ptr<const View> refer() const
+        {
+            return std::shared_ptr<const View>(std::shared_ptr<const View>(), this);
+        }
+
+        ReadGuard _snapshot;
+    };
 
     /**
-     * @brief Get count of plugins registered with each name
+     * @brief Get a read-only view of all plugins
      *
-     * @return Unordered map with plugin names as keys and count as values
+     * @return View of the current snapshot
      */
-    static std::unordered_map<std::string, size_t> getNameCounts()
+    static View view()
     {
-        std::unordered_map<std::string, size_t> counts;
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
-
-        for (const auto &plugin : plugins) {
-            counts[plugin.name]++;
-        }
-        return counts;
+        return View();
     }
 
     /**
      * @brief Get iterator to the beginning of all plugins
      *
+     * @note  The iterator owns a view of the current snapshot (see `View`), so it stays valid whatever writers do,
+     *        until it and its copies are destroyed. Prefer `view()`, which doesn't allocate
+     *
      * @return const_iterator pointing to the first plugin
      */
     static const_iterator begin()
     {
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        return getPlugins().begin();
+        return const_iterator(std::shared_ptr<const View>(new View()), 0);
     }
 
     /**
-     * @brief Get iterator to the end of all plugins
+     * @brief Get iterator to the end of all plugins, it is the end of any view, see `begin()`
      *
      * @return const_iterator pointing past the last plugin
      */
     static const_iterator end()
     {
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        return getPlugins().end();
+        return const_iterator();
     }
 
     /**
      * @brief Get all plugin information
      *
+     * @note  All plugins are copied, use `view()` to iterate them without copying
+     *
      * @return Vector of PluginInfo containing all registered plugins
      */
     static std::vector<PluginInfoType> getAllPluginInfo()
     {
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        return getPlugins();  // Copy the vector
+        std::vector<PluginInfoType> result;
+        ReadGuard snapshot;
+
+        result.reserve(snapshot->plugins.size());
+        for (const auto &plugin : snapshot->plugins) {
+            result.push_back(*plugin);  // Copy the plugin
+        }
+        return result;
     }
 
     /**
      * @brief Get plugins by name
      *
+     * @note  The matching plugins are copied, use `view().byName()` to iterate them without copying
+     *
      * @param[in] name Plugin name to filter by
      * @return Vector of PluginInfo for plugins with the specified name
      */
-    static std::vector<PluginInfoType> getPluginInfoByName(const std::string &name)
+    static std::vector<PluginInfoType> getPluginInfoByName(std::string_view name)
     {
         std::vector<PluginInfoType> result;
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
+        ReadGuard snapshot;
 
-        for (const auto &plugin : plugins) {
-            if (plugin.name == name) {
-                result.push_back(plugin);
-            }
-        }
+        auto append = [&result](const PluginInfoType & plugin) {
+            result.push_back(plugin);
+        };
+        forEachByName(*snapshot, findNameId(*snapshot, name), append);
         return result;
     }
 
@@ -260,10 +1913,9 @@ public:
     template<typename Func>
     static void forEach(Func func)
     {
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
-        for (const auto &plugin : plugins) {
-            func(plugin);
+        ReadGuard snapshot;
+        for (const auto &plugin : snapshot->plugins) {
+            func(*plugin);
         }
     }
 
@@ -274,15 +1926,23 @@ public:
      * @param[in] func Function to execute for each matching plugin
      */
     template<typename Func>
-    static void forEachByName(const std::string &name, Func func)
+    static void forEachByName(std::string_view name, Func func)
     {
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
-        for (const auto &plugin : plugins) {
-            if (plugin.name == name) {
-                func(plugin);
-            }
-        }
+        ReadGuard snapshot;
+        forEachByName(*snapshot, findNameId(*snapshot, name), func);
+    }
+
+    /**
+     * @brief Execute a function for each plugin with a specific interned name
+     *
+     * @param[in] id Interned plugin name, see `internName()`
+     * @param[in] func Function to execute for each matching plugin
+     */
+    template<typename Func>
+    static void forEachByName(PluginNameId id, Func func)
+    {
+        ReadGuard snapshot;
+        forEachByName(*snapshot, id, func);
     }
 
     /**
@@ -292,22 +1952,79 @@ public:
      */
     static size_t getPluginCount()
     {
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        return getPlugins().size();
+        ReadGuard snapshot;
+        return snapshot->plugins.size();
     }
 
     /**
      * @brief Find plugin by predicate
      *
+     * @note  The iterator owns its snapshot like the one of `begin()`, prefer `view().findIf()`
+     *
      * @param[in] pred Predicate function that returns true for matching plugin
      * @return const_iterator pointing to first matching plugin, or end() if not found
      */
     template<typename Predicate>
     static const_iterator findIf(Predicate pred)
     {
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
-        return std::find_if(plugins.begin(), plugins.end(), pred);
+        return std::find_if(begin(), end(), pred);
+    }
+
+    /**
+     * @brief Create the instances of all plugins with a factory, so the first `get()` doesn't pay for it
+     *
+     * @note  The factories run in parallel on `thread_num` threads (including the caller), using the configuration
+     *        of `std::thread`. A plugin which already has an instance is skipped, and so is a scoped plugin (see
+     *        `PluginScope`), whose instances are created by the first `get()` on each core or thread
+     * @note  A plugin is only created after all plugins of its dependencies (see `registerPlugin()`), which are
+     *        created as well even if they are not selected. The plugins on a dependency cycle are not created
+     *
+     * @param[in] thread_num Number of threads, 1 to run all factories in the caller
+     * @return Construction report of each created plugin, in registration order
+     */
+    static std::vector<PluginWarmUpResult> warmUp(size_t thread_num = 1)
+    {
+        return warmUpIf([](const PluginInfoType &) {
+            return true;
+        }, thread_num);
+    }
+
+    /**
+     * @brief Create the instances of the plugins with the given names, see `warmUp()`
+     *
+     * @param[in] names Plugin names, all plugins of each name are created
+     * @param[in] thread_num Number of threads, 1 to run all factories in the caller
+     * @return Construction report of each created plugin, in registration order
+     */
+    static std::vector<PluginWarmUpResult> warmUp(const std::vector<std::string_view> &names, size_t thread_num = 1)
+    {
+        ReadGuard snapshot;
+        std::vector<bool> selected(snapshot->names.size(), false);
+        for (auto name : names) {
+            auto id = findNameId(*snapshot, name);
+            if (id != PluginNameId::Invalid) {
+                selected[static_cast<size_t>(id)] = true;
+            }
+        }
+
+        auto pred = [&selected](const PluginInfoType & plugin) {
+            return selected[static_cast<size_t>(plugin.name_id)];
+        };
+        return warmUp(*snapshot, pred, thread_num);
+    }
+
+    /**
+     * @brief Create the instances of the plugins matching a predicate, see `warmUp()`
+     *
+     * @param[in] pred Predicate function that returns true for plugins to create
+     * @param[in] thread_num Number of threads, 1 to run all factories in the caller
+     * @return Construction report of each created plugin, in registration order
+     */
+    template<typename Predicate>
+    static std::vector<PluginWarmUpResult> warmUpIf(Predicate pred, size_t thread_num = 1)
+    {
+        ReadGuard snapshot;
+        return warmUp(*snapshot, pred, thread_num);
     }
 
     /**
@@ -316,20 +2033,17 @@ public:
      * @param[in] name Plugin name to remove
      * @return true if plugin was found and removed, false otherwise
      */
-    static bool removePlugin(const std::string &name)
+    static bool removePlugin(std::string_view name)
     {
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
-
-        auto it = std::find_if(plugins.begin(), plugins.end(), [&name](const PluginInfoType & plugin) {
-            return plugin.name == name;
-        });
-
-        if (it != plugins.end()) {
-            plugins.erase(it);
-            return true;
+        std::lock_guard<std::recursive_mutex> lock(getState().mutex);
+        auto id = findNameId(currentLocked(), name);
+        if (id == PluginNameId::Invalid) {
+            return false;
         }
-        return false;
+
+        return removeLocked([id](const PluginInfoType & plugin) {
+            return plugin.name_id == id;
+        }, 1) > 0;
     }
 
     /**
@@ -338,22 +2052,17 @@ public:
      * @param[in] name Plugin name to remove all instances of
      * @return Number of plugins removed
      */
-    static size_t removeAllPlugins(const std::string &name)
+    static size_t removeAllPlugins(std::string_view name)
     {
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
-
-        size_t removed_count = 0;
-        auto it = plugins.begin();
-        while (it != plugins.end()) {
-            if (it->name == name) {
-                it = plugins.erase(it);
-                ++removed_count;
-            } else {
-                ++it;
-            }
+        std::lock_guard<std::recursive_mutex> lock(getState().mutex);
+        auto id = findNameId(currentLocked(), name);
+        if (id == PluginNameId::Invalid) {
+            return 0;
         }
-        return removed_count;
+
+        return removeLocked([id](const PluginInfoType & plugin) {
+            return plugin.name_id == id;
+        });
     }
 
     /**
@@ -368,18 +2077,11 @@ public:
         static_assert(std::is_base_of_v<T, PluginType>, "PluginType must inherit from base type T");
 
         auto type_key = std::type_index(typeid(PluginType));
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
+        std::lock_guard<std::recursive_mutex> lock(getState().mutex);
 
-        auto it = std::find_if(plugins.begin(), plugins.end(), [&type_key](const PluginInfoType & plugin) {
+        return removeLocked([&type_key](const PluginInfoType & plugin) {
             return plugin.type_idx == type_key;
-        });
-
-        if (it != plugins.end()) {
-            plugins.erase(it);
-            return true;
-        }
-        return false;
+        }, 1) > 0;
     }
 
     /**
@@ -394,20 +2096,11 @@ public:
         static_assert(std::is_base_of_v<T, PluginType>, "PluginType must inherit from base type T");
 
         auto type_key = std::type_index(typeid(PluginType));
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
+        std::lock_guard<std::recursive_mutex> lock(getState().mutex);
 
-        size_t removed_count = 0;
-        auto it = plugins.begin();
-        while (it != plugins.end()) {
-            if (it->type_idx == type_key) {
-                it = plugins.erase(it);
-                ++removed_count;
-            } else {
-                ++it;
-            }
-        }
-        return removed_count;
+        return removeLocked([&type_key](const PluginInfoType & plugin) {
+            return plugin.type_idx == type_key;
+        });
     }
 
     /**
@@ -418,23 +2111,20 @@ public:
      * @return true if plugin was found and removed, false otherwise
      */
     template <typename PluginType>
-    static bool removeSpecificPlugin(const std::string &name)
+    static bool removeSpecificPlugin(std::string_view name)
     {
         static_assert(std::is_base_of_v<T, PluginType>, "PluginType must inherit from base type T");
 
         auto type_key = std::type_index(typeid(PluginType));
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
-
-        auto it = std::find_if(plugins.begin(), plugins.end(), [&name, &type_key](const PluginInfoType & plugin) {
-            return plugin.name == name && plugin.type_idx == type_key;
-        });
-
-        if (it != plugins.end()) {
-            plugins.erase(it);
-            return true;
+        std::lock_guard<std::recursive_mutex> lock(getState().mutex);
+        auto id = findNameId(currentLocked(), name);
+        if (id == PluginNameId::Invalid) {
+            return false;
         }
-        return false;
+
+        return removeLocked([id, &type_key](const PluginInfoType & plugin) {
+            return plugin.name_id == id && plugin.type_idx == type_key;
+        }, 1) > 0;
     }
 
     /**
@@ -446,20 +2136,78 @@ public:
     template<typename Predicate>
     static size_t removeIf(Predicate pred)
     {
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
+        std::lock_guard<std::recursive_mutex> lock(getState().mutex);
+        return removeLocked(pred);
+    }
 
-        size_t removed_count = 0;
-        auto it = plugins.begin();
-        while (it != plugins.end()) {
-            if (pred(*it)) {
-                it = plugins.erase(it);
-                ++removed_count;
-            } else {
-                ++it;
+    /**
+     * @brief Release the instances of the plugins with a factory which are idle and only referenced by the registry,
+     *        they are created again by the next `get()`. It can be called periodically, or when memory is low
+     *
+     * @note  A plugin is idle if it hasn't been looked up since the previous call which was at least `idle_time` ago,
+     *        so the precision of `idle_time` is the calling period. A `PluginHandle` keeps its instance referenced
+     * @note  An instance is freed once the lookups which started before the call are done, the lookups meanwhile get
+     *        the same instance again instead of creating another one
+     * @note  Each instance of a `PluginScope::PerThread` plugin is idle if its thread hasn't looked it up, the
+     *        instances of the exited threads are already released
+     *
+     * @param[in] idle_time Minimum idle time, 0 to release all instances only referenced by the registry
+     * @return Number of released instances
+     */
+    static size_t evictIdle(std::chrono::milliseconds idle_time = std::chrono::milliseconds(0))
+    {
+        auto &state = getState();
+        std::lock_guard<std::recursive_mutex> lock(state.mutex);
+
+        auto now_ms = getTimeMs();
+        auto epoch = state.access_epoch.load(std::memory_order_relaxed);
+        const auto &current = currentLocked();
+        auto check_idle = [&](uint32_t access_epoch, int64_t &idle_since_ms) {
+            if (access_epoch == epoch) {
+                // Used since the previous call
+                idle_since_ms = -1;
+            } else if (idle_since_ms < 0) {
+                idle_since_ms = state.epoch_start_ms;
+            }
+            return (idle_time.count() == 0) ||
+                   ((idle_since_ms >= 0) && ((now_ms - idle_since_ms) >= idle_time.count()));
+        };
+        SnapshotPtr next;
+        size_t evicted_count = 0;
+        for (size_t i = 0; i < current.plugins.size(); i++) {
+            auto &plugin = *current.plugins[i];
+            if (!plugin.hasFactory() || !plugin.hasInstance()) {
+                continue;
+            }
+            if (plugin.scope == PluginScope::PerThread) {
+                // Each thread touches the same entry, so its instance tracks its own accesses
+                evicted_count += plugin.releaseThreadInstances(check_idle);
+                continue;
+            }
+            if (!check_idle(plugin._access_epoch.load(std::memory_order_relaxed), plugin._idle_since_ms) ||
+                    plugin.isShared()) {
+                continue;
+            }
+
+            // Replace the entry, readers of the current snapshot may still use the instance, so the new entry reuses
+            // it until they are done
+            if (!next) {
+                next = makeSnapshot(current);
             }
+            auto evicted = makePluginInfo(plugin);
+            evicted->clearInstances();
+            evicted->evictInstances(plugin);
+            next->plugins[i] = std::move(evicted);
+            evicted_count += plugin.getInstanceNum();
         }
-        return removed_count;
+
+        state.access_epoch.store(epoch + 1, std::memory_order_relaxed);
+        state.epoch_start_ms = now_ms;
+        if (next) {
+            publishLocked(std::move(next));
+        }
+
+        return evicted_count;
     }
 
     /**
@@ -469,10 +2217,39 @@ public:
      */
     static size_t clearAllPlugins()
     {
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
-        size_t removed_count = plugins.size();
-        plugins.clear();
+        std::lock_guard<std::recursive_mutex> lock(getState().mutex);
+        const auto &current = currentLocked();
+        size_t removed_count = current.plugins.size();
+        if (removed_count == 0) {
+            return 0;
+        }
+
+        // Interned names are kept
+        auto next = makeSnapshot(current);
+        next->plugins.clear();
+        rebuildIndexes(*next);
+        publishLocked(std::move(next));
+        return removed_count;
+    }
+
+    /**
+     * @brief Remove all plugins and release all the storage of the registry, including the interned names
+     *
+     * @note  Unlike `clearAllPlugins()`, the IDs of the interned names become invalid, and the names returned by
+     *        `getName()` are released. It is mainly for tests which check that all the memory is released, and must
+     *        not be called while the registry is used by other threads
+     *
+     * @return Number of plugins removed
+     */
+    static size_t reset()
+    {
+        auto &state = getState();
+        std::lock_guard<std::recursive_mutex> lock(state.mutex);
+        size_t removed_count = currentLocked().plugins.size();
+
+        publishLocked(makeSnapshot());
+        state.names.clear();
+        Vector<RetiredSnapshot>().swap(state.retired);
         return removed_count;
     }
 
@@ -481,27 +2258,118 @@ public:
      *
      * @tparam PluginType Specific plugin type to register
      * @param[in] name Plugin name (can be duplicated)
-     * @param[in] factory Factory function to create instances
+     * @param[in] factory Factory function to create instances, it is stored inline and its captures must fit in
+     *                    `inplace_function_default_capacity` bytes (checked at compile time). A larger factory must
+     *                    be passed explicitly as a `std::function`, which keeps its captures on the heap
+     * @param[in] dependencies Names of the plugins which `warmUp()` creates before this one (optional), they don't
+     *                         need to be registered yet
      */
     template <typename PluginType>
-    static void registerPlugin(const std::string &name, FactoryFunc factory)
+    static void registerPlugin(
+        std::string_view name, FactoryFunc factory, const std::vector<std::string_view> &dependencies = {}
+    )
+    {
+        registerPlugin<PluginType>(name, std::move(factory), PluginScope::Global, dependencies);
+    }
+
+    /**
+     * @brief Register a plugin with any callable as factory, e.g. a lambda, see the other overloads
+     */
+    template <typename PluginType, typename Factory, typename = EnableIfFactory<Factory>>
+    static void registerPlugin(
+        std::string_view name, Factory &&factory, const std::vector<std::string_view> &dependencies = {}
+    )
+    {
+        registerPlugin<PluginType>(name, makeFactory(std::forward<Factory>(factory)), dependencies);
+    }
+
+    /**
+     * @brief Register a plugin with any callable as factory and instance scope, see the other overloads
+     */
+    template <typename PluginType, typename Factory, typename = EnableIfFactory<Factory>>
+    static void registerPlugin(
+        std::string_view name, Factory &&factory, PluginScope scope,
+        const std::vector<std::string_view> &dependencies = {}
+    )
+    {
+        registerPlugin<PluginType>(name, makeFactory(std::forward<Factory>(factory)), scope, dependencies);
+    }
+
+    /**
+     * @brief Register a plugin with factory function and instance scope
+     *
+     * @note  With `PluginScope::PerCore` or `PluginScope::PerThread`, `get()` returns the instance of the calling
+     *        core or thread, which is created by the factory on its first `get()`. Stateful plugins (e.g. codecs or
+     *        scratch buffers) then don't need to be shared behind locks
+     * @note  A per-core instance may still be used from another core if the caller migrates, pin the task to make it
+     *        exclusive. A per-thread instance is found through a `thread_local` cache, without locking
+     * @note  A per-thread instance is released when its thread exits (for threads which run `thread_local`
+     *        destructors, e.g. `std::thread`), or by `evictIdle()` once idle
+     *
+     * @tparam PluginType Specific plugin type to register
+     * @param[in] name Plugin name (can be duplicated)
+     * @param[in] factory Factory function to create instances, see the other overload
+     * @param[in] scope Which callers share an instance
+     * @param[in] dependencies Names of the plugins which `warmUp()` creates before this one (optional)
+     */
+    template <typename PluginType>
+    static void registerPlugin(
+        std::string_view name, FactoryFunc factory, PluginScope scope,
+        const std::vector<std::string_view> &dependencies = {}
+    )
     {
         static_assert(std::is_base_of_v<T, PluginType>, "PluginType must inherit from base type T");
 
         auto type_key = std::type_index(typeid(PluginType));
-        std::string type_name = getRealTypeName<PluginType>();
 
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
+        std::lock_guard<std::recursive_mutex> lock(getState().mutex);
+        SnapshotPtr next;
+        auto &snapshot = editLocked(next);
+        auto id = internNameLocked(snapshot, name);
 
         // Check if this exact combination already exists
-        for (const auto &plugin : plugins) {
-            if (plugin.name == name && plugin.type_idx == type_key) {
+        for (auto slot : snapshot.name_slots[static_cast<size_t>(id)]) {
+            if (snapshot.plugins[slot]->type_idx == type_key) {
                 return; // Already registered
             }
         }
 
-        plugins.emplace_back(name, type_key, std::move(factory), type_name);
+        auto plugin = makePluginInfo(name, type_key, std::move(factory), id, scope);
+        for (auto dependency : dependencies) {
+            plugin->dependencies.push_back(internNameLocked(snapshot, dependency));
+        }
+        addPlugin(snapshot, std::move(plugin));
+        commitLocked(std::move(next));
+    }
+
+    /**
+     * @brief Register several plugins at once, they are published together when `func` returns, so the registry is
+     *        copied once instead of once per plugin
+     *
+     * @note  It is only useful once the registry has been used, before that the registrations don't copy it
+     * @note  `func` runs with the registry locked and should only call `registerPlugin()`, `registerSingleton()` and
+     *        `internName()`. The lookups from `func` don't see the plugins it registers
+     *
+     * @param[in] func Function which registers the plugins
+     */
+    template <typename Func>
+    static void registerBatch(Func func)
+    {
+        auto &state = getState();
+        std::lock_guard<std::recursive_mutex> lock(state.mutex);
+        if (state.batch != nullptr) {
+            // Nested batch, published by the outer one
+            func();
+            return;
+        }
+
+        SnapshotPtr next;
+        state.batch = &editLocked(next);
+        function_guard publish([&state, &next]() {
+            state.batch = nullptr;
+            commitLocked(std::move(next));
+        });
+        func();
     }
 
     /**
@@ -510,77 +2378,177 @@ public:
      * @tparam PluginType Specific plugin type to register
      * @param[in] name Plugin name (can be duplicated)
      * @param[in] instance Pre-created singleton instance to register
+     * @return true if the instance was registered, false if the plugin of the same name and type has a per-thread or
+     *         per-core scope, which is left unchanged since one instance can't serve every thread or core
      */
     template <typename PluginType>
-    static void registerSingleton(const std::string &name, std::shared_ptr<PluginType> instance)
+    static bool registerSingleton(std::string_view name, std::shared_ptr<PluginType> instance)
     {
         static_assert(std::is_base_of_v<T, PluginType>, "PluginType must inherit from base type T");
 
         auto type_key = std::type_index(typeid(PluginType));
-        std::string type_name = getRealTypeName<PluginType>();
-
-        std::lock_guard<std::recursive_mutex> lock(getMutex());
-        auto &plugins = getPlugins();
 
-        // Check if this exact combination already exists
-        for (auto &plugin : plugins) {
-            if (plugin.name == name && plugin.type_idx == type_key) {
-                plugin.instance = std::static_pointer_cast<T>(instance);
-                return;
+        std::lock_guard<std::recursive_mutex> lock(getState().mutex);
+        SnapshotPtr next;
+        auto &snapshot = editLocked(next);
+        auto id = internNameLocked(snapshot, name);
+        auto plugin = makePluginInfo(
+                          name, type_key, std::static_pointer_cast<T>(instance), id
+                      );
+
+        // Check if this exact combination already exists, the entry is replaced since readers may still use it
+        for (auto slot : snapshot.name_slots[static_cast<size_t>(id)]) {
+            if (snapshot.plugins[slot]->type_idx == type_key) {
+                if (snapshot.plugins[slot]->scope != PluginScope::Global) {
+                    return false;
+                }
+                plugin->factory = snapshot.plugins[slot]->factory;
+                plugin->dependencies = snapshot.plugins[slot]->dependencies;
+                snapshot.plugins[slot] = std::move(plugin);
+                commitLocked(std::move(next));
+                return true;
             }
         }
 
-        plugins.emplace_back(name, type_key, std::static_pointer_cast<T>(instance), type_name);
+        addPlugin(snapshot, std::move(plugin));
+        commitLocked(std::move(next));
+        return true;
     }
 
     /**
      * @brief Get real type name (demangled)
      *
      * @tparam PluginType Type to get name for
-     * @return Demangled type name
+     * @return Demangled type name, cached for the whole program
      */
     template<typename PluginType>
-    static std::string getRealTypeName()
+    static const std::string &getRealTypeName()
     {
-        return demangleTypeName(typeid(PluginType).name());
+        return PluginTypeName(typeid(PluginType)).str();
     }
 
     /**
      * @brief Get real type name from type_index (demangled)
      *
      * @param[in] type_idx Type index to get name for
-     * @return Demangled type name
+     * @return Demangled type name, cached for the whole program
      */
-    static std::string getRealTypeName(const std::type_index &type_idx)
+    static const std::string &getRealTypeName(const std::type_index &type_idx)
+    {
+        return PluginTypeName(type_idx).str();
+    }
+
+protected:
+    // Same as `get<PluginType>()`, the scope of the plugin is stored in `scope` if it is registered
+    template <typename PluginType>
+    static std::shared_ptr<PluginType> get(PluginScope &scope)
+    {
+        static_assert(std::is_base_of_v<T, PluginType>, "PluginType must inherit from base type T");
+
+        auto type_key = std::type_index(typeid(PluginType));
+        ReadGuard snapshot;
+
+        auto it = snapshot->type_index.find(type_key);
+        if (it == snapshot->type_index.end()) {
+            return nullptr;
+        }
+        const auto &plugin = snapshot->plugins[it->second];
+        scope = plugin->scope;
+        return std::static_pointer_cast<PluginType>(getInstance(plugin));
+    }
+
+    template <typename BaseType, typename PluginType, typename BaseAllocator>
+    friend struct PluginRegistrar;
+    template <typename BaseType, typename PluginType, typename BaseAllocator>
+    friend class PluginHandle;
+};
+
+/**
+ * @brief Typed plugin handle, which caches the instance resolved by `PluginRegistry<T>::get<PluginType>()` and only
+ *        resolves it again after the registry is modified. Dereferencing it in steady state is one relaxed load and
+ *        compare, without touching any reference count
+ *
+ * @note  The handle keeps the instance alive until it is resolved again or reset. It is not thread-safe, each thread
+ *        should use its own handle, which also gives it the instance of its thread for a `PluginScope::PerThread`
+ *        plugin. For a `PluginScope::PerCore` plugin, the handle also resolves the instance again when the thread
+ *        runs on another core
+ *
+ * @tparam T Base class type for plugins
+ * @tparam PluginType Specific plugin type to get
+ * @tparam Allocator Allocator of the registry (optional)
+ */
+template <typename T, typename PluginType, typename Allocator>
+class PluginHandle {
+public:
+    PluginHandle()
+        : _registry_generation(&PluginRegistry<T, Allocator>::getState().generation)
     {
-        return demangleTypeName(type_idx.name());
     }
 
-private:
     /**
-     * @brief Demangle type name for better readability
+     * @brief Get the instance, resolving it again if the registry has been modified
      *
-     * @param[in] mangled_name Mangled type name
-     * @return Demangled type name or original name if demangling fails
+     * @return Pointer to the plugin instance, or nullptr if it is not registered
      */
-    static std::string demangleTypeName(const char *mangled_name)
+    PluginType *get()
     {
-#ifdef __GNUG__
-        int status = 0;
-        std::unique_ptr<char, void(*)(void *)> result {
-            abi::__cxa_demangle(mangled_name, 0, 0, &status),
-            std::free
-        };
-        return (status == 0) ? result.get() : mangled_name;
-#else
-        // For non-GCC compilers, return original mangled name
-        return mangled_name;
-#endif
+        if ((_registry_generation->load(std::memory_order_relaxed) != _generation) ||
+                ((_core != NO_CORE) && (_core != detail::getPluginCoreId()))) {
+            resolve();
+        }
+        return _ptr;
     }
 
-protected:
-    template <typename BaseType, typename PluginType>
-    friend struct PluginRegistrar;
+    PluginType *operator->()
+    {
+        return get();
+    }
+
+    PluginType &operator*()
+    {
+        return *get();
+    }
+
+    explicit operator bool()
+    {
+        return get() != nullptr;
+    }
+
+    /**
+     * @brief Release the cached instance, the next access resolves it again
+     */
+    void reset()
+    {
+        _instance.reset();
+        _ptr = nullptr;
+        _generation = 0;
+        _core = NO_CORE;
+    }
+
+private:
+    static constexpr size_t NO_CORE = SIZE_MAX;
+
+    void resolve()
+    {
+        // Read the generation and the core first, so a modification or a migration during `get()` triggers another
+        // resolution
+        _generation = _registry_generation->load(std::memory_order_acquire);
+        auto core = detail::getPluginCoreId();
+        PluginScope scope = PluginScope::Global;
+        _instance = PluginRegistry<T, Allocator>::template get<PluginType>(scope);
+        _core = (scope == PluginScope::PerCore) ? core : NO_CORE;
+        _ptr = _instance.get();
+        if (_ptr == nullptr) {
+            // Not registered or failed to create, try again next time
+            _generation = 0;
+        }
+    }
+
+    const std::atomic<uint32_t> *_registry_generation;
+    uint32_t _generation = 0;
+    size_t _core = NO_CORE;                 // Core of the instance, only for a `PluginScope::PerCore` plugin
+    PluginType *_ptr = nullptr;
+    std::shared_ptr<PluginType> _instance;
 };
 
 /**
@@ -588,19 +2556,56 @@ protected:
  *
  * @tparam BaseType Base type for the plugin registry
  * @tparam PluginType Type of plugin to register
+ * @tparam Allocator Allocator of the registry (optional)
  */
-template <typename BaseType, typename PluginType>
+template <typename BaseType, typename PluginType, typename Allocator>
 struct PluginRegistrar {
+    using FactoryFunc = typename PluginRegistry<BaseType, Allocator>::FactoryFunc;
+
+    template <typename F>
+    using EnableIfCreator = std::enable_if_t<
+        std::is_invocable_r_v<typename PluginRegistry<BaseType, Allocator>::InstancePtr, std::decay_t<F> &>
+    >;
+
     /**
      * @brief Constructor that registers the plugin type
      *
+     * @param[in] creator Function that creates instances of the plugin, e.g. a lambda returning
+     *                    `std::shared_ptr<PluginType>`. It is stored as the factory without another wrapper, so it
+     *                    must fit inline, see `PluginRegistry::registerPlugin()`
+     */
+    template <typename F, typename = EnableIfCreator<F>>
+    PluginRegistrar(std::string_view name, F &&creator)
+    {
+        PluginRegistry<BaseType, Allocator>::template registerPlugin<PluginType>(name, std::forward<F>(creator));
+    }
+
+    /**
+     * @brief Constructor that registers the plugin type with its dependencies
+     *
+     * @param[in] name Plugin name
+     * @param[in] dependencies Names of the plugins to create first
      * @param[in] creator Function that creates instances of the plugin
      */
-    PluginRegistrar(const std::string &name, std::function<std::shared_ptr<PluginType>()> creator)
+    template <typename F, typename = EnableIfCreator<F>>
+    PluginRegistrar(std::string_view name, std::vector<std::string_view> dependencies, F &&creator)
     {
-        PluginRegistry<BaseType>::template registerPlugin<PluginType>(name, [creator]() {
-            return std::static_pointer_cast<BaseType>(creator());
-        });
+        PluginRegistry<BaseType, Allocator>::template registerPlugin<PluginType>(
+            name, std::forward<F>(creator), dependencies
+        );
+    }
+
+    /**
+     * @brief Constructor that registers the plugin type with its instance scope
+     *
+     * @param[in] name Plugin name
+     * @param[in] scope Which callers share an instance
+     * @param[in] creator Function that creates instances of the plugin
+     */
+    template <typename F, typename = EnableIfCreator<F>>
+    PluginRegistrar(std::string_view name, PluginScope scope, F &&creator)
+    {
+        PluginRegistry<BaseType, Allocator>::template registerPlugin<PluginType>(name, std::forward<F>(creator), scope);
     }
 
     /**
@@ -609,9 +2614,9 @@ struct PluginRegistrar {
      * @param[in] name Plugin name
      * @param[in] instance Pre-created singleton instance to register
      */
-    PluginRegistrar(const std::string &name, std::shared_ptr<PluginType> instance)
+    PluginRegistrar(std::string_view name, std::shared_ptr<PluginType> instance)
     {
-        PluginRegistry<BaseType>::template registerSingleton<PluginType>(name, instance);
+        PluginRegistry<BaseType, Allocator>::template registerSingleton<PluginType>(name, instance);
     }
 };
 
@@ -651,3 +2656,57 @@ struct PluginRegistrar {
     ESP_UTILS_REGISTER_PLUGIN_WITH_CONSTRUCTOR(BaseType, PluginType, name, []() {  \
         return std::make_shared<PluginType>(__VA_ARGS__); \
     })
+
+/**
+ * @brief Registration macro with dependencies, the plugin is default constructed
+ *
+ * @param BaseType Base type for the plugin registry
+ * @param PluginType Plugin type to register
+ * @param name Plugin name
+ * @param ... Names of the plugins to create first, see `PluginRegistry::warmUp()`
+ */
+#define ESP_UTILS_REGISTER_PLUGIN_WITH_DEPENDENCIES(BaseType, PluginType, name, ...)                  \
+    static esp_utils::PluginRegistrar<BaseType, PluginType> _##PluginType##_registrar(name, {__VA_ARGS__}, []() { \
+        return std::make_shared<PluginType>(); \
+    });
+
+/**
+ * @brief Registration macro with instance scope, the plugin is default constructed
+ *
+ * @param BaseType Base type for the plugin registry
+ * @param PluginType Plugin type to register
+ * @param name Plugin name
+ * @param scope Which callers share an instance, e.g. `esp_utils::PluginScope::PerThread`
+ */
+#define ESP_UTILS_REGISTER_PLUGIN_WITH_SCOPE(BaseType, PluginType, name, scope)                       \
+    static esp_utils::PluginRegistrar<BaseType, PluginType> _##PluginType##_registrar(name, scope, []() { \
+        return std::make_shared<PluginType>(); \
+    });
+
+/**
+ * @brief Declare the compile-time plugin table of a registry, by specializing `esp_utils::PluginStaticTable`. It must
+ *        be right after the definition of the base type (in its header), at global scope, so every translation unit
+ *        using the registry sees it
+ *
+ * @param BaseType Base type for the plugin registry
+ */
+#define ESP_UTILS_DECLARE_STATIC_PLUGINS(BaseType)                                                  \
+    template <>                                                                                     \
+    struct esp_utils::PluginStaticTable<BaseType> {                                                 \
+        static esp_utils::PluginDescriptorTable<BaseType> get();                                    \
+    }
+
+/**
+ * @brief Define the compile-time plugin table of a registry, in one source file and at global scope. It doesn't
+ *        compile if `ESP_UTILS_DECLARE_STATIC_PLUGINS()` is not visible. Unlike `ESP_UTILS_REGISTER_PLUGIN()`,
+ *        nothing runs at startup: the table is constant and is only read on the first use of the registry
+ *
+ * @param BaseType Base type for the plugin registry
+ * @param ... Plugin descriptors, made by `esp_utils::makeStaticPlugin()`
+ */
+#define ESP_UTILS_DEFINE_STATIC_PLUGINS(BaseType, ...)                                              \
+    esp_utils::PluginDescriptorTable<BaseType> esp_utils::PluginStaticTable<BaseType>::get()        \
+    {                                                                                               \
+        static constexpr esp_utils::PluginDescriptor<BaseType> descriptors[] = { __VA_ARGS__ };     \
+        return {descriptors, sizeof(descriptors) / sizeof(descriptors[0])};                         \
+    }
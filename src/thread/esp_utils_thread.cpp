@@ -36,7 +36,7 @@ thread_config_guard::thread_config_guard(const ThreadConfig &config)
     ESP_UTILS_LOG_TRACE_GUARD();
 
     ESP_UTILS_LOGD("Param: config(%p)", &config);
-#if ESP_UTILS_CONF_LOG_LEVEL == ESP_UTILS_LOG_LEVEL_DEBUG
+#if ESP_UTILS_LOG_CURRENT_LEVEL == ESP_UTILS_LOG_LEVEL_DEBUG
     config.dump();
 #endif
 
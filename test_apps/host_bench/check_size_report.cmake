@@ -0,0 +1,69 @@
+# Print the section sizes of the check sample built with inline and out-of-line failure reporting:
+#
+#   cmake -DSIZE_TOOL=size -DINLINE_OBJECTS=<objects> -DOUTLINE_OBJECTS=<objects> -P check_size_report.cmake
+#
+# `.text` is the code kept on the hot path, `.text.unlikely` is the code moved out of it by the cold attribute.
+cmake_minimum_required(VERSION 3.16)
+
+set(SECTIONS .text .text.unlikely .rodata)
+
+function(get_section_sizes objects out_prefix)
+    execute_process(
+        COMMAND ${SIZE_TOOL} -A ${objects}
+        OUTPUT_VARIABLE output
+        RESULT_VARIABLE result
+    )
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Failed to run ${SIZE_TOOL}")
+    endif()
+
+    string(REPLACE "\n" ";" lines "${output}")
+    foreach(section ${SECTIONS} total)
+        set(${out_prefix}_${section} 0)
+    endforeach()
+    foreach(line ${lines})
+        if(line MATCHES "^(\\.[A-Za-z0-9_.]+)[ \t]+([0-9]+)")
+            set(name ${CMAKE_MATCH_1})
+            set(bytes ${CMAKE_MATCH_2})
+            # Merge the sub-sections of `.rodata` (strings, constants)
+            if(name MATCHES "^\\.rodata")
+                set(name .rodata)
+            endif()
+            if(name IN_LIST SECTIONS)
+                math(EXPR ${out_prefix}_${name} "${${out_prefix}_${name}} + ${bytes}")
+                math(EXPR ${out_prefix}_total "${${out_prefix}_total} + ${bytes}")
+            endif()
+        endif()
+    endforeach()
+    foreach(section ${SECTIONS} total)
+        set(${out_prefix}_${section} ${${out_prefix}_${section}} PARENT_SCOPE)
+    endforeach()
+endfunction()
+
+get_section_sizes("${INLINE_OBJECTS}" inline)
+get_section_sizes("${OUTLINE_OBJECTS}" outline)
+
+message("Check code size (bytes)")
+message("  variant   .text  .text.unlikely  .rodata   total")
+foreach(variant inline outline)
+    set(row "")
+    foreach(section ${SECTIONS} total)
+        string(LENGTH "${${variant}_${section}}" len)
+        if(section STREQUAL .text.unlikely)
+            set(width 16)
+        else()
+            set(width 8)
+        endif()
+        math(EXPR pad "${width} - ${len}")
+        string(REPEAT " " ${pad} spaces)
+        string(APPEND row "${spaces}${${variant}_${section}}")
+    endforeach()
+    string(LENGTH "${variant}" len)
+    math(EXPR pad "9 - ${len}")
+    string(REPEAT " " ${pad} spaces)
+    message("  ${variant}${spaces}${row}")
+endforeach()
+
+if(NOT outline_.text LESS inline_.text)
+    message(FATAL_ERROR "Out-of-line reporting doesn't reduce the hot code size")
+endif()
@@ -0,0 +1,58 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+/**
+ * Sample of typical check usage, it is only compiled (not linked) to compare the code size of the check macros
+ */
+#include <stdbool.h>
+#include <stddef.h>
+#define ESP_UTILS_LOG_TAG "BenchCheck"
+#include "esp_lib_utils.h"
+
+typedef struct {
+    int *values;
+    size_t count;
+    int min;
+    int max;
+} bench_check_buffer_t;
+
+#define BENCH_CHECK_FUNCTION(index)                                                                     \
+    int bench_check_sum_##index(const bench_check_buffer_t *buffer, size_t offset)                     \
+    {                                                                                                   \
+        ESP_UTILS_CHECK_NULL_RETURN(buffer, -1, "Invalid buffer");                                      \
+        ESP_UTILS_CHECK_NULL_RETURN(buffer->values, -1, "Invalid values of buffer(@%p)", buffer);       \
+        ESP_UTILS_CHECK_FALSE_RETURN(offset < buffer->count, -1, "Invalid offset: %d, count: %d",       \
+                                     (int)offset, (int)buffer->count);                                  \
+                                                                                                        \
+        int sum = 0;                                                                                    \
+        for (size_t i = offset; i < buffer->count; i++) {                                               \
+            ESP_UTILS_CHECK_VALUE_RETURN(buffer->values[i], buffer->min, buffer->max, -1,               \
+                                         "Invalid value at %d", (int)i);                                \
+            sum += buffer->values[i] * (index + 1);                                                     \
+        }                                                                                               \
+                                                                                                        \
+        return sum;                                                                                     \
+    }                                                                                                   \
+                                                                                                        \
+    bool bench_check_fill_##index(bench_check_buffer_t *buffer, int value)                             \
+    {                                                                                                   \
+        ESP_UTILS_CHECK_NULL_RETURN(buffer, false, "Invalid buffer");                                   \
+        ESP_UTILS_CHECK_VALUE_RETURN(value, buffer->min, buffer->max, false, "Invalid fill value");     \
+                                                                                                        \
+        for (size_t i = 0; i < buffer->count; i++) {                                                    \
+            buffer->values[i] = value + index;                                                          \
+        }                                                                                               \
+                                                                                                        \
+        return true;                                                                                    \
+    }
+
+BENCH_CHECK_FUNCTION(0)
+BENCH_CHECK_FUNCTION(1)
+BENCH_CHECK_FUNCTION(2)
+BENCH_CHECK_FUNCTION(3)
+BENCH_CHECK_FUNCTION(4)
+BENCH_CHECK_FUNCTION(5)
+BENCH_CHECK_FUNCTION(6)
+BENCH_CHECK_FUNCTION(7)
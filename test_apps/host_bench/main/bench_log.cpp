@@ -0,0 +1,223 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define ESP_UTILS_LOG_TAG "BenchCpp"
+#include "esp_lib_utils.h"
+#include "bench_log.h"
+
+#define BENCH_DEFAULT_ITERATIONS    (100000)
+#define BENCH_MAX_THREADS           (8)
+
+namespace {
+
+struct BenchResult {
+    std::string name;
+    double ns_per_call;
+    double bytes_per_call;
+};
+
+/**
+ * Redirect `stdout` to a temporary file, so the log output can be counted without flooding the terminal
+ */
+class OutputCounter {
+public:
+    OutputCounter()
+    {
+        char path[] = "/tmp/esp_utils_bench_XXXXXX";
+
+        fflush(stdout);
+        _saved_fd = dup(STDOUT_FILENO);
+        _file_fd = mkstemp(path);
+        if ((_saved_fd < 0) || (_file_fd < 0)) {
+            fprintf(stderr, "Failed to redirect stdout\n");
+            exit(EXIT_FAILURE);
+        }
+        unlink(path);
+        dup2(_file_fd, STDOUT_FILENO);
+    }
+
+    ~OutputCounter()
+    {
+        fflush(stdout);
+        dup2(_saved_fd, STDOUT_FILENO);
+        close(_saved_fd);
+        close(_file_fd);
+    }
+
+    void reset()
+    {
+        fflush(stdout);
+        if (ftruncate(_file_fd, 0) != 0) {
+            fprintf(stderr, "Failed to truncate output file\n");
+        }
+        lseek(_file_fd, 0, SEEK_SET);
+    }
+
+    size_t bytes()
+    {
+        struct stat st = {};
+
+        fflush(stdout);
+        fstat(_file_fd, &st);
+
+        return static_cast<size_t>(st.st_size);
+    }
+
+private:
+    int _saved_fd = -1;
+    int _file_fd = -1;
+};
+
+template <typename Func>
+BenchResult runBench(OutputCounter &counter, const std::string &name, int calls, Func &&func)
+{
+    counter.reset();
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+    return {name, ns / calls, static_cast<double>(counter.bytes()) / calls};
+}
+
+#define BENCH_LOOP(log_macro, value)  do {                      \
+        for (int i = 0; i < iterations; i++) {                  \
+            log_macro("C++ message %d, value %s", i, value);    \
+        }                                                       \
+    } while (0)
+
+void cxxLog(int level, int iterations)
+{
+    switch (level) {
+    case ESP_UTILS_LOG_LEVEL_DEBUG:
+        BENCH_LOOP(ESP_UTILS_LOGD, "debug");
+        break;
+    case ESP_UTILS_LOG_LEVEL_INFO:
+        BENCH_LOOP(ESP_UTILS_LOGI, "info");
+        break;
+    case ESP_UTILS_LOG_LEVEL_WARNING:
+        BENCH_LOOP(ESP_UTILS_LOGW, "warning");
+        break;
+    default:
+        BENCH_LOOP(ESP_UTILS_LOGE, "error");
+        break;
+    }
+}
+
+__attribute__((noinline)) int tracedFunction(int value)
+{
+    ESP_UTILS_LOG_TRACE_GUARD();
+
+    return value + 1;
+}
+
+class TracedClass {
+public:
+    __attribute__((noinline)) int tracedMethod(int value)
+    {
+        ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+        return value + _offset;
+    }
+
+private:
+    int _offset = 1;
+};
+
+const char *const level_names[] = {"LOGD", "LOGI", "LOGW", "LOGE"};
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int iterations = (argc > 1) ? atoi(argv[1]) : BENCH_DEFAULT_ITERATIONS;
+    if (iterations <= 0) {
+        fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<BenchResult> results;
+    {
+        OutputCounter counter;
+
+        for (int level = ESP_UTILS_LOG_LEVEL_DEBUG; level < ESP_UTILS_LOG_LEVEL_NONE; level++) {
+            results.push_back(runBench(counter, std::string("C ") + level_names[level], iterations, [&]() {
+                bench_c_log(level, iterations);
+            }));
+            results.push_back(runBench(counter, std::string("C++ ") + level_names[level], iterations, [&]() {
+                cxxLog(level, iterations);
+            }));
+        }
+        results.push_back(runBench(counter, "C++ LOGI_FMT", iterations, [&]() {
+            for (int i = 0; i < iterations; i++) {
+                ESP_UTILS_LOGI_FMT("C++ message {}, value {}", i, "info");
+            }
+        }));
+
+#if ESP_UTILS_CONF_LOG_ENABLE_SINK
+        // Runtime-disabled path: the level is compiled in, but no sink accepts it
+        esp_utils_log_sink_set_level_mask(
+            &esp_utils_log_sink_console, ESP_UTILS_LOG_LEVEL_MASK_FROM(ESP_UTILS_LOG_LEVEL_ERROR)
+        );
+        results.push_back(runBench(counter, "C++ LOGI (filtered by sinks)", iterations, [&]() {
+            cxxLog(ESP_UTILS_LOG_LEVEL_INFO, iterations);
+        }));
+        esp_utils_log_sink_set_level_mask(&esp_utils_log_sink_console, ESP_UTILS_LOG_LEVEL_MASK_ALL);
+#endif
+
+        volatile int sink_value = 0;
+        results.push_back(runBench(counter, "Trace guard", iterations, [&]() {
+            for (int i = 0; i < iterations; i++) {
+                sink_value = tracedFunction(i);
+            }
+        }));
+        TracedClass traced_object;
+        results.push_back(runBench(counter, "Trace guard with this", iterations, [&]() {
+            for (int i = 0; i < iterations; i++) {
+                sink_value = traced_object.tracedMethod(i);
+            }
+        }));
+        (void)sink_value;
+
+        // All threads write to the same stream
+        for (int threads = 1; threads <= BENCH_MAX_THREADS; threads *= 2) {
+            int per_thread = (iterations + threads - 1) / threads;
+            results.push_back(runBench(
+            counter, "C++ LOGI x " + std::to_string(threads) + " threads", per_thread * threads, [&]() {
+                std::vector<std::thread> workers;
+                for (int t = 0; t < threads; t++) {
+                    workers.emplace_back(cxxLog, ESP_UTILS_LOG_LEVEL_INFO, per_thread);
+                }
+                for (auto &worker : workers) {
+                    worker.join();
+                }
+            }));
+        }
+    }
+
+#if ESP_UTILS_CONF_LOG_ENABLE_TRACE_RECORD
+    esp_utils::log_trace::release();
+#endif
+
+#ifdef BENCH_VARIANT
+    printf("Variant: %s\n", BENCH_VARIANT);
+#endif
+    printf("Iterations: %d, log level: %d\n", iterations, ESP_UTILS_CONF_LOG_LEVEL);
+    printf("%-32s %12s %12s\n", "Case", "ns/call", "bytes/call");
+    for (const auto &result : results) {
+        printf("%-32s %12.1f %12.1f\n", result.name.c_str(), result.ns_per_call, result.bytes_per_call);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,19 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Log `iterations` messages of `level` from a C translation unit
+ */
+void bench_c_log(int level, int iterations);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,32 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#define ESP_UTILS_LOG_TAG "BenchC"
+#include "esp_lib_utils.h"
+#include "bench_log.h"
+
+#define BENCH_LOOP(log_macro, value)  do {                  \
+        for (int i = 0; i < iterations; i++) {              \
+            log_macro("C message %d, value %s", i, value);  \
+        }                                                   \
+    } while (0)
+
+void bench_c_log(int level, int iterations)
+{
+    switch (level) {
+    case ESP_UTILS_LOG_LEVEL_DEBUG:
+        BENCH_LOOP(ESP_UTILS_LOGD, "debug");
+        break;
+    case ESP_UTILS_LOG_LEVEL_INFO:
+        BENCH_LOOP(ESP_UTILS_LOGI, "info");
+        break;
+    case ESP_UTILS_LOG_LEVEL_WARNING:
+        BENCH_LOOP(ESP_UTILS_LOGW, "warning");
+        break;
+    default:
+        BENCH_LOOP(ESP_UTILS_LOGE, "error");
+        break;
+    }
+}
@@ -0,0 +1,417 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#define ESP_UTILS_LOG_TAG "BenchPlugin"
+#include "esp_lib_utils.h"
+
+#define BENCH_DEFAULT_ITERATIONS    (1000000)
+#define BENCH_PLUGIN_NUM            (1000)
+#define BENCH_MAX_THREADS           (8)
+#define BENCH_SCALE_MAX_PLUGINS     (10000)
+#define BENCH_ALLOC_HEADER_SIZE     (alignof(std::max_align_t))
+
+// Bytes currently allocated by `new`, used to measure the memory of the registry
+static std::atomic<long long> bench_allocated_bytes(0);
+
+void *operator new (size_t size)
+{
+    auto ptr = static_cast<char *>(malloc(size + BENCH_ALLOC_HEADER_SIZE));
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<size_t *>(ptr) = size;
+    bench_allocated_bytes += size;
+
+    return ptr + BENCH_ALLOC_HEADER_SIZE;
+}
+
+void *operator new[](size_t size)
+{
+    return operator new (size);
+}
+
+void *operator new (size_t size, const std::nothrow_t &) noexcept
+{
+    try {
+        return operator new (size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return operator new (size, std::nothrow);
+}
+
+void operator delete (void *ptr) noexcept
+{
+    if (ptr == nullptr) {
+        return;
+    }
+    auto base = static_cast<char *>(ptr) - BENCH_ALLOC_HEADER_SIZE;
+    bench_allocated_bytes -= *reinterpret_cast<size_t *>(base);
+    free(base);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    operator delete (ptr);
+}
+
+void operator delete (void *ptr, size_t) noexcept
+{
+    operator delete (ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept
+{
+    operator delete (ptr);
+}
+
+void operator delete (void *ptr, const std::nothrow_t &) noexcept
+{
+    operator delete (ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept
+{
+    operator delete (ptr);
+}
+
+namespace {
+
+struct BenchResult {
+    std::string name;
+    double ns_per_call;
+};
+
+class BenchPluginBase {
+public:
+    virtual ~BenchPluginBase() = default;
+
+    virtual size_t id() const = 0;
+};
+
+template <size_t N>
+class BenchPlugin : public BenchPluginBase {
+public:
+    size_t id() const override
+    {
+        return N;
+    }
+};
+
+// Never registered, used to measure a failed lookup
+class BenchMissingPlugin : public BenchPluginBase {
+public:
+    size_t id() const override
+    {
+        return BENCH_PLUGIN_NUM;
+    }
+};
+
+using BenchRegistry = esp_utils::PluginRegistry<BenchPluginBase>;
+
+using RegisterFunc = void (*)(const std::string &name);
+using GetFunc = size_t (*)();
+
+template <size_t N>
+void registerPlugin(const std::string &name)
+{
+    BenchRegistry::registerPlugin<BenchPlugin<N>>(name, []() {
+        return std::make_shared<BenchPlugin<N>>();
+    });
+}
+
+template <size_t N>
+size_t getPlugin()
+{
+    auto plugin = BenchRegistry::get<BenchPlugin<N>>();
+    return plugin ? plugin->id() : 0;
+}
+
+// Select the plugin types at runtime, so the scalability cases don't need more types
+template <size_t... Is>
+constexpr std::array<RegisterFunc, sizeof...(Is)> makeRegisterTable(std::index_sequence<Is...>)
+{
+    return {&registerPlugin<Is>...};
+}
+
+template <size_t... Is>
+constexpr std::array<GetFunc, sizeof...(Is)> makeGetTable(std::index_sequence<Is...>)
+{
+    return {&getPlugin<Is>...};
+}
+
+constexpr auto register_table = makeRegisterTable(std::make_index_sequence<BENCH_PLUGIN_NUM>());
+constexpr auto get_table = makeGetTable(std::make_index_sequence<BENCH_PLUGIN_NUM>());
+
+void registerPlugins()
+{
+    for (size_t i = 0; i < BENCH_PLUGIN_NUM; i++) {
+        register_table[i]("Bench_Plugin_" + std::to_string(i));
+    }
+}
+
+template <typename Func>
+BenchResult runBench(const std::string &name, int calls, Func &&func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+
+    return {name, ns / calls};
+}
+
+template <typename PluginType>
+BenchResult benchGetByType(const std::string &name, int iterations)
+{
+    volatile size_t sink = 0;
+    auto result = runBench(name, iterations, [&]() {
+        for (int i = 0; i < iterations; i++) {
+            auto plugin = BenchRegistry::get<PluginType>();
+            sink = sink + (plugin ? plugin->id() : 0);
+        }
+    });
+    (void)sink;
+
+    return result;
+}
+
+template <typename PluginType>
+BenchResult benchHandle(const std::string &name, int iterations)
+{
+    BenchRegistry::Handle<PluginType> handle;
+    volatile size_t sink = 0;
+    auto result = runBench(name, iterations, [&]() {
+        for (int i = 0; i < iterations; i++) {
+            auto plugin = handle.get();
+            sink = sink + (plugin ? plugin->id() : 0);
+        }
+    });
+    (void)sink;
+
+    return result;
+}
+
+template <typename Key>
+BenchResult benchGetByName(const std::string &name, const Key &plugin_name, int iterations)
+{
+    volatile size_t sink = 0;
+    auto result = runBench(name, iterations, [&]() {
+        for (int i = 0; i < iterations; i++) {
+            auto plugin = BenchRegistry::get(plugin_name);
+            sink = sink + (plugin ? plugin->id() : 0);
+        }
+    });
+    (void)sink;
+
+    return result;
+}
+
+// Every thread calls `func` `iterations` times, the result is the wall time per call of all threads
+template <typename Func>
+BenchResult benchConcurrent(const std::string &name, int thread_num, int iterations, Func &&func)
+{
+    return runBench(name + " x" + std::to_string(thread_num), thread_num * iterations, [&]() {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < thread_num; i++) {
+            threads.emplace_back([&]() {
+                volatile size_t sink = 0;
+                for (int j = 0; j < iterations; j++) {
+                    sink = sink + func();
+                }
+                (void)sink;
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    });
+}
+
+struct ScaleResult {
+    int plugin_num;
+    double register_us_per_plugin;
+    double bytes_per_plugin;
+    double get_by_type_ns;
+    double get_by_name_ns;
+    double get_all_ns;
+    double for_each_ns;
+    std::vector<std::pair<double, double>> concurrent_ns;   // get<T>() and get(name) for 1, 2, 4... threads
+};
+
+/**
+ * Register `plugin_num` plugins and measure the lookups of the last one. Beyond `BENCH_PLUGIN_NUM`, the plugin types
+ * are reused with other names, so the type index is capped to `BENCH_PLUGIN_NUM` entries
+ */
+ScaleResult benchScale(int plugin_num, int iterations)
+{
+    ScaleResult result = {};
+    result.plugin_num = plugin_num;
+
+    // Each size uses new names, the interned names are never released
+    std::vector<std::string> names;
+    names.reserve(plugin_num);
+    for (int i = 0; i < plugin_num; i++) {
+        names.push_back("Bench_" + std::to_string(plugin_num) + "_Plugin_" + std::to_string(i));
+    }
+
+    long long bytes_before = bench_allocated_bytes.load();
+    // The registry has been used already, so the plugins are registered in a batch to copy it only once
+    result.register_us_per_plugin = runBench("", plugin_num, [&]() {
+        BenchRegistry::registerBatch([&]() {
+            for (int i = 0; i < plugin_num; i++) {
+                register_table[i % BENCH_PLUGIN_NUM](names[i]);
+            }
+        });
+    }).ns_per_call / 1000;
+    result.bytes_per_plugin = static_cast<double>(bench_allocated_bytes.load() - bytes_before) / plugin_num;
+
+    auto get_last = get_table[(plugin_num - 1) % BENCH_PLUGIN_NUM];
+    const auto &last_name = names.back();
+    volatile size_t sink = 0;
+    result.get_by_type_ns = runBench("", iterations, [&]() {
+        for (int i = 0; i < iterations; i++) {
+            sink = sink + get_last();
+        }
+    }).ns_per_call;
+    result.get_by_name_ns = benchGetByName("", last_name, iterations).ns_per_call;
+    result.get_all_ns = runBench("", iterations, [&]() {
+        for (int i = 0; i < iterations; i++) {
+            sink = sink + BenchRegistry::getAll(last_name).size();
+        }
+    }).ns_per_call;
+    int for_each_iterations = std::max(1, iterations / plugin_num);
+    result.for_each_ns = runBench("", for_each_iterations, [&]() {
+        for (int i = 0; i < for_each_iterations; i++) {
+            BenchRegistry::forEach([&sink](const auto & plugin) {
+                sink = sink + plugin.hasInstance();
+            });
+        }
+    }).ns_per_call;
+
+    for (int thread_num = 1; thread_num <= BENCH_MAX_THREADS; thread_num *= 2) {
+        double by_type = benchConcurrent("", thread_num, iterations, get_last).ns_per_call;
+        double by_name = benchConcurrent("", thread_num, iterations, [&last_name]() {
+            auto plugin = BenchRegistry::get(last_name);
+            return plugin ? plugin->id() : 0;
+        }).ns_per_call;
+        result.concurrent_ns.emplace_back(by_type, by_name);
+    }
+    (void)sink;
+
+    BenchRegistry::clearAllPlugins();
+
+    return result;
+}
+
+void printScaleResults(const std::vector<ScaleResult> &results)
+{
+    printf("\nScalability (ns/call, registration in us/plugin, memory in bytes/plugin):\n");
+    printf(
+        "%8s %12s %12s %10s %10s %10s %12s\n", "Plugins", "Register", "Memory", "get<T>", "get(name)", "getAll",
+        "forEach"
+    );
+    for (const auto &result : results) {
+        printf(
+            "%8d %12.2f %12.1f %10.1f %10.1f %10.1f %12.1f\n", result.plugin_num, result.register_us_per_plugin,
+            result.bytes_per_plugin, result.get_by_type_ns, result.get_by_name_ns, result.get_all_ns,
+            result.for_each_ns
+        );
+    }
+
+    printf("\nConcurrent readers (wall ns/call of all threads, get<T>() / get(name)):\n");
+    printf("%8s", "Plugins");
+    for (int thread_num = 1; thread_num <= BENCH_MAX_THREADS; thread_num *= 2) {
+        printf(" %16s", ("x" + std::to_string(thread_num)).c_str());
+    }
+    printf("\n");
+    for (const auto &result : results) {
+        printf("%8d", result.plugin_num);
+        for (const auto &ns : result.concurrent_ns) {
+            printf(" %7.1f / %6.1f", ns.first, ns.second);
+        }
+        printf("\n");
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    int iterations = (argc > 1) ? atoi(argv[1]) : BENCH_DEFAULT_ITERATIONS;
+    int max_plugins = (argc > 2) ? atoi(argv[2]) : BENCH_SCALE_MAX_PLUGINS;
+    if ((iterations <= 0) || (max_plugins <= 0)) {
+        fprintf(stderr, "Usage: %s [iterations] [max_plugins]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::vector<BenchResult> results;
+    results.push_back(runBench("Register " + std::to_string(BENCH_PLUGIN_NUM) + " plugins", BENCH_PLUGIN_NUM, []() {
+        registerPlugins();
+    }));
+    if (BenchRegistry::getPluginCount() != BENCH_PLUGIN_NUM) {
+        fprintf(stderr, "Unexpected plugin count: %zu\n", BenchRegistry::getPluginCount());
+        return EXIT_FAILURE;
+    }
+
+    // The first call of each plugin creates its instance, the following ones only look it up
+    results.push_back(benchGetByType<BenchPlugin<0>>("get<T>() first", iterations));
+    results.push_back(benchGetByType<BenchPlugin<BENCH_PLUGIN_NUM / 2>>("get<T>() middle", iterations));
+    results.push_back(benchGetByType<BenchPlugin<BENCH_PLUGIN_NUM - 1>>("get<T>() last", iterations));
+    results.push_back(benchGetByType<BenchMissingPlugin>("get<T>() missing", iterations));
+    results.push_back(benchHandle<BenchPlugin<BENCH_PLUGIN_NUM - 1>>("Handle<T> last", iterations));
+    results.push_back(benchGetByName("get(name) first", "Bench_Plugin_0", iterations));
+    std::string last_name = "Bench_Plugin_" + std::to_string(BENCH_PLUGIN_NUM - 1);
+    results.push_back(benchGetByName("get(name) last", last_name, iterations));
+    results.push_back(benchGetByName("get(name) missing", "Bench_Plugin_Missing", iterations));
+    results.push_back(benchGetByName("get(name id) last", BenchRegistry::findNameId(last_name), iterations));
+
+    // Lookups don't take any lock, so the throughput should scale with the threads
+    for (int thread_num = 1; thread_num <= BENCH_MAX_THREADS; thread_num *= 2) {
+        results.push_back(benchConcurrent("get<T>() last", thread_num, iterations, []() {
+            auto plugin = BenchRegistry::get<BenchPlugin<BENCH_PLUGIN_NUM - 1>>();
+            return plugin ? plugin->id() : 0;
+        }));
+    }
+    for (int thread_num = 1; thread_num <= BENCH_MAX_THREADS; thread_num *= 2) {
+        results.push_back(benchConcurrent("get(name) last", thread_num, iterations, [&last_name]() {
+            auto plugin = BenchRegistry::get(last_name);
+            return plugin ? plugin->id() : 0;
+        }));
+    }
+
+    BenchRegistry::clearAllPlugins();
+
+    std::vector<ScaleResult> scale_results;
+    for (int plugin_num = 10; plugin_num <= max_plugins; plugin_num *= 10) {
+        scale_results.push_back(benchScale(plugin_num, iterations));
+    }
+
+    printf("Iterations: %d, plugins: %d\n", iterations, BENCH_PLUGIN_NUM);
+    printf("%-32s %12s\n", "Case", "ns/call");
+    for (const auto &result : results) {
+        printf("%-32s %12.1f\n", result.name.c_str(), result.ns_per_call);
+    }
+    printScaleResults(scale_results);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,74 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#define ESP_UTILS_LOG_TAG "TestBacktrace"
+#include "esp_lib_utils.h"
+
+#if ESP_UTILS_CONF_CHECK_ENABLE_BACKTRACE
+#define TEST_EXPORT_SIZE    (1024)
+
+static __attribute__((noinline)) bool test_check_positive(int value)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(value > 0, false, "Invalid value: %d", value);
+
+    return true;
+}
+
+static __attribute__((noinline)) bool test_call_check(int value)
+{
+    bool ret = test_check_positive(value);
+    // Keep the call out of the tail position, so this frame stays on the stack
+    __asm__ volatile("" ::: "memory");
+
+    return ret;
+}
+
+TEST_CASE("Test check failure backtrace on C", "[utils][check][backtrace][C]")
+{
+    esp_utils_check_backtrace_record_t records[ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE];
+
+    esp_utils_check_backtrace_clear();
+    TEST_ASSERT_EQUAL(0, esp_utils_check_backtrace_read(records, ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE));
+
+    TEST_ASSERT_TRUE(test_call_check(1));
+    TEST_ASSERT_FALSE(test_call_check(0));
+    TEST_ASSERT_FALSE(test_call_check(-1));
+
+    TEST_ASSERT_EQUAL(2, esp_utils_check_backtrace_read(records, ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE));
+    TEST_ASSERT_EQUAL(records[0].seq + 1, records[1].seq);
+    TEST_ASSERT_TRUE(records[0].timestamp_us <= records[1].timestamp_us);
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL_STRING(ESP_UTILS_LOG_TAG, records[i].tag);
+        TEST_ASSERT_EQUAL(records[0].line, records[i].line);
+        TEST_ASSERT_TRUE(records[i].depth >= 1);
+        TEST_ASSERT_TRUE(records[i].frames[0] != 0);
+    }
+
+    char report[TEST_EXPORT_SIZE];
+    size_t len = esp_utils_check_backtrace_export(report, sizeof(report));
+    TEST_ASSERT_EQUAL(strlen(report), len);
+    TEST_ASSERT_NOT_NULL(strstr(report, "ESP_UTILS_BT anchor=0x"));
+    TEST_ASSERT_NOT_NULL(strstr(report, "TestBacktrace test_check_backtrace.c:"));
+    TEST_ASSERT_NOT_NULL(strstr(report, " bt=0x"));
+
+    // The oldest records are overwritten once the ring is full
+    for (int i = 0; i < ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE + 3; i++) {
+        TEST_ASSERT_FALSE(test_call_check(-i));
+    }
+    size_t num = esp_utils_check_backtrace_read(records, ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE);
+    TEST_ASSERT_EQUAL(ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE, num);
+    TEST_ASSERT_EQUAL(ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE - 1, records[num - 1].seq - records[0].seq);
+
+    // Only the most recent records are copied if the output is too small
+    uint32_t last_seq = records[num - 1].seq;
+    TEST_ASSERT_EQUAL(1, esp_utils_check_backtrace_read(records, 1));
+    TEST_ASSERT_EQUAL(last_seq, records[0].seq);
+    TEST_ASSERT_EQUAL(ESP_UTILS_CONF_CHECK_BACKTRACE_RING_SIZE, esp_utils_check_backtrace_dump(stdout));
+}
+#endif // ESP_UTILS_CONF_CHECK_ENABLE_BACKTRACE
@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <stdbool.h>
+#include <string.h>
+#include "unity.h"
+#define ESP_UTILS_LOG_TAG "TestCounter"
+#include "esp_lib_utils.h"
+
+#if ESP_UTILS_CONF_CHECK_ENABLE_FAILURE_COUNTER
+#define TEST_EXPORT_SIZE    (256)
+
+static bool test_check_positive(int value)
+{
+    ESP_UTILS_CHECK_FALSE_RETURN(value > 0, false, "Invalid value: %d", value);
+
+    return true;
+}
+
+static bool test_check_not_null(const void *ptr)
+{
+    ESP_UTILS_CHECK_NULL_RETURN(ptr, false, "Invalid pointer");
+
+    return true;
+}
+
+static bool test_find_line(const esp_utils_check_counter_t *counter, uint32_t count, void *user_ctx)
+{
+    if (strcmp(counter->tag, ESP_UTILS_LOG_TAG) != 0) {
+        return true;
+    }
+    ((uint32_t *)user_ctx)[0]++;
+    ((uint32_t *)user_ctx)[1] += count;
+
+    return true;
+}
+
+TEST_CASE("Test check failure counters on C", "[utils][check][counter][C]")
+{
+    esp_utils_check_counter_reset();
+
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUAL(i > 0, test_check_positive(i));
+        TEST_ASSERT_EQUAL((i % 2) == 0, test_check_not_null((i % 2) == 0 ? &i : NULL));
+    }
+
+    // 1 failure of `test_check_positive()` and 5 failures of `test_check_not_null()`
+    uint32_t result[2] = {0, 0};
+    esp_utils_check_counter_foreach(test_find_line, result);
+    TEST_ASSERT_EQUAL(2, result[0]);
+    TEST_ASSERT_EQUAL(6, result[1]);
+    TEST_ASSERT_TRUE(esp_utils_check_counter_get_total() >= 6);
+
+    char report[TEST_EXPORT_SIZE];
+    size_t len = esp_utils_check_counter_export(report, sizeof(report));
+    TEST_ASSERT_EQUAL(strlen(report), len);
+    TEST_ASSERT_NOT_NULL(strstr(report, "TestCounter test_check_counter.c:"));
+    TEST_ASSERT_NOT_NULL(strstr(report, " 5\n"));
+    printf("%s", report);
+
+    // Counters stay linked but are skipped once reset
+    esp_utils_check_counter_reset();
+    result[0] = result[1] = 0;
+    esp_utils_check_counter_foreach(test_find_line, result);
+    TEST_ASSERT_EQUAL(0, result[0]);
+    TEST_ASSERT_FALSE(test_check_positive(0));
+    esp_utils_check_counter_foreach(test_find_line, result);
+    TEST_ASSERT_EQUAL(1, result[1]);
+}
+#endif // ESP_UTILS_CONF_CHECK_ENABLE_FAILURE_COUNTER
@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <memory>
+#include <string>
+#include <type_traits>
+#include "unity.h"
+#define ESP_UTILS_LOG_TAG "TestExpected"
+#include "esp_lib_utils.h"
+
+using namespace esp_utils;
+
+enum class TestExpectedError {
+    Invalid,
+    TooLarge,
+};
+
+static_assert(std::is_trivially_copyable_v<Expected<int, TestExpectedError>>, "Small results must stay trivial");
+
+static Expected<int, TestExpectedError> test_parse(int value)
+{
+    if (value < 0) {
+        return makeUnexpected(TestExpectedError::Invalid);
+    }
+    if (value > 100) {
+        return makeUnexpected(TestExpectedError::TooLarge);
+    }
+
+    return value;
+}
+
+static Expected<int, TestExpectedError> test_double(int value)
+{
+    ESP_UTILS_TRY_ASSIGN(int parsed, test_parse(value), "Parse %d failed", value);
+
+    return parsed * 2;
+}
+
+static Expected<void, TestExpectedError> test_check(int value)
+{
+    ESP_UTILS_TRY(test_parse(value), "Check %d failed", value);
+
+    return {};
+}
+
+static bool test_check_return(int value)
+{
+    ESP_UTILS_CHECK_EXPECTED_RETURN(test_parse(value), false, "Check %d failed", value);
+
+    return true;
+}
+
+static Expected<std::unique_ptr<std::string>, std::string> test_make_string(const char *str)
+{
+    if (str == nullptr) {
+        return makeUnexpected(std::string("null string"));
+    }
+
+    return std::make_unique<std::string>(str);
+}
+
+TEST_CASE("Test expected on cpp", "[utils][more][expected][CPP]")
+{
+    auto result = test_double(21);
+    TEST_ASSERT_TRUE(result.hasValue());
+    TEST_ASSERT_EQUAL(42, *result);
+    TEST_ASSERT_EQUAL(42, result.valueOr(0));
+
+    result = test_double(-1);
+    TEST_ASSERT_FALSE(result);
+    TEST_ASSERT_TRUE(result.error() == TestExpectedError::Invalid);
+    TEST_ASSERT_EQUAL(-1, result.valueOr(-1));
+
+    TEST_ASSERT_TRUE(test_check(1).hasValue());
+    TEST_ASSERT_TRUE(test_check(101).error() == TestExpectedError::TooLarge);
+    TEST_ASSERT_TRUE(test_check_return(1));
+    TEST_ASSERT_FALSE(test_check_return(-1));
+
+    auto chained = test_parse(10)
+                   .andThen([](int value) {
+        return test_parse(value * 20);
+    })
+    .transform([](int value) {
+        return value + 1;
+    });
+    TEST_ASSERT_TRUE(chained.error() == TestExpectedError::TooLarge);
+
+    auto converted = test_parse(-5).transformError([](TestExpectedError) {
+        return std::string("converted");
+    });
+    TEST_ASSERT_EQUAL_STRING("converted", converted.error().c_str());
+
+    // Non-trivial types are moved without copies
+    auto str = test_make_string("hello");
+    TEST_ASSERT_TRUE(str.hasValue());
+    TEST_ASSERT_EQUAL_STRING("hello", str.value()->c_str());
+    auto moved = std::move(str);
+    TEST_ASSERT_EQUAL_STRING("hello", (*moved)->c_str());
+    moved = test_make_string(nullptr);
+    TEST_ASSERT_EQUAL_STRING("null string", moved.error().c_str());
+}
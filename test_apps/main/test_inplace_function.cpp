@@ -0,0 +1,153 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include "unity.h"
+#define ESP_UTILS_LOG_TAG "TestInplaceFunction"
+#include "esp_lib_utils.h"
+
+using namespace esp_utils;
+
+static int test_add(int a, int b)
+{
+    return a + b;
+}
+
+struct TestCounter {
+    int value = 0;
+
+    int increase(int step)
+    {
+        value += step;
+        return value;
+    }
+};
+
+// Tracks the live copies of a callable, to check that every stored copy is destroyed
+struct TestTrackedCallable {
+    explicit TestTrackedCallable(int *alive_num)
+        : alive(alive_num)
+    {
+        (*alive)++;
+    }
+
+    TestTrackedCallable(const TestTrackedCallable &other)
+        : alive(other.alive)
+    {
+        (*alive)++;
+    }
+
+    ~TestTrackedCallable()
+    {
+        (*alive)--;
+    }
+
+    int operator()(int value) const
+    {
+        return value * 2;
+    }
+
+    int *alive;
+};
+
+static_assert(!std::is_constructible_v<inplace_function<int(int)>, int>, "Only callables can be stored");
+static_assert(
+    !std::is_constructible_v<inplace_function<int(int)>, std::string (*)(int)>, "The result must be convertible"
+);
+
+TEST_CASE("Test inplace function on cpp", "[utils][inplace_function][CPP]")
+{
+    inplace_function<int(int, int)> empty;
+    TEST_ASSERT_FALSE(empty);
+    TEST_ASSERT_TRUE(empty == nullptr);
+    TEST_ASSERT_FALSE(inplace_function<int(int, int)>(static_cast<int (*)(int, int)>(nullptr)));
+    TEST_ASSERT_FALSE(inplace_function<int(int, int)>(std::function<int(int, int)>()));
+
+    inplace_function<int(int, int)> add = test_add;
+    TEST_ASSERT_TRUE(add != nullptr);
+    TEST_ASSERT_EQUAL(3, add(1, 2));
+
+    // A mutable lambda keeps its state, the copies are independent
+    int base = 10;
+    inplace_function<int()> next = [&base, count = 0]() mutable {
+        return base + (++count);
+    };
+    TEST_ASSERT_EQUAL(11, next());
+    auto next_copy = next;
+    TEST_ASSERT_EQUAL(12, next());
+    TEST_ASSERT_EQUAL(12, next_copy());
+
+    // Member function pointer
+    TestCounter counter;
+    inplace_function<int(TestCounter &, int)> increase = &TestCounter::increase;
+    TEST_ASSERT_EQUAL(5, increase(counter, 5));
+    TEST_ASSERT_EQUAL(5, counter.value);
+
+    // Move-only arguments and a result converted to the declared type
+    inplace_function<std::shared_ptr<const int>(std::unique_ptr<int>)> share = [](std::unique_ptr<int> value) {
+        return std::shared_ptr<int>(std::move(value));
+    };
+    TEST_ASSERT_EQUAL(7, *share(std::make_unique<int>(7)));
+
+    // Non-trivial callables are copied, moved and destroyed exactly
+    int alive = 0;
+    {
+        inplace_function<int(int)> tracked = TestTrackedCallable(&alive);
+        TEST_ASSERT_EQUAL(1, alive);
+        auto copied = tracked;
+        TEST_ASSERT_EQUAL(2, alive);
+        auto moved = std::move(copied);
+        TEST_ASSERT_EQUAL(2, alive);
+        TEST_ASSERT_FALSE(copied);
+        TEST_ASSERT_EQUAL(8, moved(4));
+
+        moved = [](int value) {
+            return value * 3;
+        };
+        TEST_ASSERT_EQUAL(1, alive);
+        tracked.swap(moved);
+        TEST_ASSERT_EQUAL(1, alive);
+        TEST_ASSERT_EQUAL(3, tracked(1));
+        TEST_ASSERT_EQUAL(6, moved(3));
+        moved = nullptr;
+        TEST_ASSERT_EQUAL(0, alive);
+    }
+    TEST_ASSERT_EQUAL(0, alive);
+
+    // Larger captures need a larger capacity
+    std::string text = "inplace";
+    inplace_function<size_t(), sizeof(std::string) + sizeof(int *)> length = [text, &base]() {
+        return text.size() + base;
+    };
+    TEST_ASSERT_EQUAL(17, length());
+    auto large = [text, &base]() {
+        return text.size() + base;
+    };
+    static_assert(!inplace_function<size_t()>::fits<decltype(large)>, "The captures don't fit by default");
+    static_assert(inplace_function<size_t()>::fits<std::function<size_t()>>, "A `std::function` fits by default");
+    TEST_ASSERT_EQUAL(17, inplace_function<size_t()>(std::function<size_t()>(large))());
+}
+
+TEST_CASE("Test inplace function with function guard on cpp", "[utils][inplace_function][CPP]")
+{
+    int called = 0;
+    {
+        function_guard<inplace_function<void(int)>, int> guard([&called](int value) {
+            called += value;
+        }, 2);
+    }
+    TEST_ASSERT_EQUAL(2, called);
+
+    {
+        function_guard<inplace_function<void()>> guard([&called]() {
+            called++;
+        });
+        guard.release();
+    }
+    TEST_ASSERT_EQUAL(2, called);
+}
@@ -0,0 +1,53 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include "unity.h"
+#define ESP_UTILS_LOG_TAG "TestLocalGlobal"
+#include "esp_lib_utils.h"
+#include "test_local_config.h"
+
+// Uses the global configuration
+TEST_LOCAL_CONFIG_DEFINE(global)
+
+static int test_local_config_max_logs(int level)
+{
+    // Only the info, warning and error logs are called
+    if (level <= ESP_UTILS_LOG_LEVEL_INFO) {
+        return 3;
+    }
+
+    return ESP_UTILS_LOG_LEVEL_NONE - level;
+}
+
+static void test_local_config_assert(const test_local_config_result_t *result, int method, int level)
+{
+    TEST_ASSERT_EQUAL(method, result->check_method);
+    TEST_ASSERT_EQUAL(level, result->log_level);
+    // Logs filtered at compile time never evaluate their arguments, the log backend may still filter at runtime
+    if (level == ESP_UTILS_LOG_LEVEL_NONE) {
+        TEST_ASSERT_EQUAL(0, result->evaluated_logs);
+    } else {
+        TEST_ASSERT_LESS_OR_EQUAL(test_local_config_max_logs(level), result->evaluated_logs);
+    }
+    TEST_ASSERT_TRUE(result->check_passed);
+    TEST_ASSERT_FALSE(result->check_failed);
+}
+
+TEST_CASE("Test local check and log config on c", "[utils][check][log][local][C]")
+{
+    test_local_config_result_t result = {};
+
+    test_local_config_run_strict(&result);
+    test_local_config_assert(&result, ESP_UTILS_CHECK_HANDLE_WITH_ERROR_LOG, ESP_UTILS_LOG_LEVEL_INFO);
+
+    test_local_config_run_silent(&result);
+    test_local_config_assert(&result, ESP_UTILS_CHECK_HANDLE_WITH_NONE, ESP_UTILS_LOG_LEVEL_NONE);
+
+    test_local_config_run_assert(&result);
+    test_local_config_assert(&result, ESP_UTILS_CHECK_HANDLE_WITH_ASSERT, ESP_UTILS_LOG_LEVEL_ERROR);
+
+    test_local_config_run_global(&result);
+    test_local_config_assert(&result, ESP_UTILS_CONF_CHECK_HANDLE_METHOD, ESP_UTILS_CONF_LOG_LEVEL);
+}
@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#pragma once
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    int check_method;       /*!< Check handle method resolved in the translation unit */
+    int log_level;          /*!< Log level resolved in the translation unit */
+    int evaluated_logs;     /*!< Number of log calls (one per level) whose arguments were evaluated */
+    bool check_passed;      /*!< Result of a passing check */
+    bool check_failed;      /*!< Result of a failing check (only run if the method doesn't assert) */
+} test_local_config_result_t;
+
+void test_local_config_run_strict(test_local_config_result_t *result);
+void test_local_config_run_silent(test_local_config_result_t *result);
+void test_local_config_run_assert(test_local_config_result_t *result);
+void test_local_config_run_global(test_local_config_result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * Define `test_local_config_run_<name>()` in the current translation unit, the log and check macros in it are
+ * resolved with the local configuration of that unit
+ */
+#define TEST_LOCAL_CONFIG_DEFINE(name)                                                                  \
+    static int test_local_##name##_evaluate(int *count)                                                 \
+    {                                                                                                   \
+        return ++(*count);                                                                              \
+    }                                                                                                   \
+                                                                                                        \
+    static bool test_local_##name##_check(int value)                                                    \
+    {                                                                                                   \
+        ESP_UTILS_CHECK_FALSE_RETURN(value > 0, false, "Invalid value: %d", value);                     \
+                                                                                                        \
+        return true;                                                                                    \
+    }                                                                                                   \
+                                                                                                        \
+    void test_local_config_run_##name(test_local_config_result_t *result)                               \
+    {                                                                                                   \
+        int count = 0;                                                                                  \
+                                                                                                        \
+        /* Debug logs are not used, since ESP-IDF may filter them again with its own level */           \
+        ESP_UTILS_LOGI("Info %d", test_local_##name##_evaluate(&count));                                \
+        ESP_UTILS_LOGW("Warning %d", test_local_##name##_evaluate(&count));                             \
+        ESP_UTILS_LOGE("Error %d", test_local_##name##_evaluate(&count));                               \
+                                                                                                        \
+        result->check_method = ESP_UTILS_CHECK_HANDLE_METHOD;                                           \
+        result->log_level = ESP_UTILS_LOG_CURRENT_LEVEL;                                                \
+        result->evaluated_logs = count;                                                                 \
+        result->check_passed = test_local_##name##_check(1);                                            \
+        result->check_failed = (ESP_UTILS_CHECK_HANDLE_METHOD != ESP_UTILS_CHECK_HANDLE_WITH_ASSERT) ?   \
+                               test_local_##name##_check(0) : false;                                    \
+    }
@@ -0,0 +1,13 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+// Assertions and error logs only
+#define ESP_UTILS_CHECK_LOCAL_HANDLE_METHOD (ESP_UTILS_CHECK_HANDLE_WITH_ASSERT)
+#define ESP_UTILS_LOG_LOCAL_LEVEL           (ESP_UTILS_LOG_LEVEL_ERROR)
+#define ESP_UTILS_LOG_TAG "TestLocalAssert"
+#include "esp_lib_utils.h"
+#include "test_local_config.h"
+
+TEST_LOCAL_CONFIG_DEFINE(assert)
@@ -0,0 +1,77 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <string.h>
+#include "unity.h"
+#define ESP_UTILS_LOG_TAG "TestDict"
+#include "esp_lib_utils.h"
+
+#if ESP_UTILS_CONF_LOG_ENABLE_DICT
+static uint8_t test_frame[2 * ESP_UTILS_CONF_LOG_DICT_BUFFER_SIZE + 8];
+static size_t test_frame_len = 0;
+
+static void test_output(void *user_ctx, const uint8_t *data, size_t len)
+{
+    (void)user_ctx;
+    TEST_ASSERT_TRUE(len <= sizeof(test_frame));
+    memcpy(test_frame, data, len);
+    test_frame_len = len;
+}
+
+// Remove the escaping and check the length and checksum, return the payload length
+static size_t test_unescape_frame(uint8_t *payload)
+{
+    uint8_t raw[sizeof(test_frame)];
+    size_t raw_len = 0;
+
+    TEST_ASSERT_EQUAL(ESP_UTILS_LOG_DICT_SYNC, test_frame[0]);
+    for (size_t i = 1; i < test_frame_len; i++) {
+        TEST_ASSERT_NOT_EQUAL('\n', test_frame[i]);
+        TEST_ASSERT_NOT_EQUAL(ESP_UTILS_LOG_DICT_SYNC, test_frame[i]);
+        if (test_frame[i] == ESP_UTILS_LOG_DICT_ESCAPE) {
+            raw[raw_len++] = test_frame[++i] ^ ESP_UTILS_LOG_DICT_ESCAPE_XOR;
+        } else {
+            raw[raw_len++] = test_frame[i];
+        }
+    }
+    TEST_ASSERT_EQUAL(raw[0] + 2, raw_len);
+
+    uint8_t checksum = 0;
+    for (size_t i = 1; i < raw_len - 1; i++) {
+        checksum += raw[i];
+    }
+    TEST_ASSERT_EQUAL(checksum, raw[raw_len - 1]);
+    memcpy(payload, raw + 1, raw[0]);
+
+    return raw[0];
+}
+
+TEST_CASE("Test log dictionary encoding on C", "[utils][log][dict][C]")
+{
+    uint8_t payload[ESP_UTILS_CONF_LOG_DICT_BUFFER_SIZE];
+    const char *text_msg = "[I][TestDict][test_log_dict.c:0052](test): Value 10, name test_name, ratio 0.50";
+
+    esp_utils_log_dict_set_output(test_output, NULL);
+
+    ESP_UTILS_LOGI("Value %d, name %s, ratio %.2f", 10, "test_name", 0.5);
+    size_t len = test_unescape_frame(payload);
+    printf("Frame size: %d bytes (%d bytes as text)\n", (int)test_frame_len, (int)strlen(text_msg));
+    TEST_ASSERT_TRUE(test_frame_len * 3 < strlen(text_msg));
+    // Arguments are at the end of the payload: 10 (zigzag), "test_name", 0.5 (double)
+    TEST_ASSERT_EQUAL(20, payload[len - 19]);
+    TEST_ASSERT_EQUAL(9, payload[len - 18]);
+    TEST_ASSERT_EQUAL(0, memcmp(payload + len - 17, "test_name", 9));
+
+    // Long strings are truncated, but the frame stays valid
+    char long_str[ESP_UTILS_CONF_LOG_DICT_BUFFER_SIZE * 2];
+    memset(long_str, 'a', sizeof(long_str) - 1);
+    long_str[sizeof(long_str) - 1] = '\0';
+    ESP_UTILS_LOGW("Long string %s, value %d", long_str, -1);
+    len = test_unescape_frame(payload);
+    TEST_ASSERT_TRUE(len <= ESP_UTILS_CONF_LOG_DICT_BUFFER_SIZE);
+
+    esp_utils_log_dict_set_output(NULL, NULL);
+}
+#endif // ESP_UTILS_CONF_LOG_ENABLE_DICT
@@ -0,0 +1,51 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include "unity.h"
+#define ESP_UTILS_LOG_TAG "TestFormat"
+#include "esp_lib_utils.h"
+
+using namespace esp_utils;
+
+#define TEST_FORMAT(expected, format, ...) do {                                                             \
+        char buffer[64];                                                                                    \
+        size_t len = log_format::formatTo(buffer, sizeof(buffer), ESP_UTILS_LOG_FMT_STRING(format), ##__VA_ARGS__); \
+        TEST_ASSERT_EQUAL_STRING(expected, buffer);                                                         \
+        TEST_ASSERT_EQUAL(strlen(expected), len);                                                           \
+    } while (0)
+
+enum class TestFormatEnum : uint8_t {
+    Value = 7,
+};
+
+TEST_CASE("Test log format on cpp", "[utils][log][format][CPP]")
+{
+    TEST_FORMAT("plain {text}", "plain {{text}}");
+    TEST_FORMAT("-12 34 255 true x", "{} {} {} {} {}", -12, 34U, static_cast<uint8_t>(255), true, 'x');
+    TEST_FORMAT("int64: -9223372036854775808", "int64: {}", INT64_MIN);
+    TEST_FORMAT("ff FF 0xff 17 101 0b101", "{:x} {:X} {:#x} {:o} {:b} {:#b}", 255, 255, 255, 15, 5, 5);
+    TEST_FORMAT("[   42] [42   ] [ 42  ] [00042] [-0042] [+42]", "[{:5}] [{:<5}] [{:^5}] [{:05}] [{:05}] [{:+}]",
+                42, 42, 42, 42, -42, 42);
+    TEST_FORMAT("[abc  ] [  abc] [**abc] [ab]", "[{:5}] [{:>5}] [{:*>5}] [{:.2}]", "abc", "abc", "abc", "abc");
+    TEST_FORMAT("str string_view (null)", "{} {} {}", std::string("str"), std::string_view("string_view"),
+                static_cast<const char *>(nullptr));
+    TEST_FORMAT("1.500 2.5 1.000000e+02", "{:.3f} {} {:e}", 1.5, 2.5F, 100.0);
+    TEST_FORMAT("A 66 7", "{:c} {:d} {}", 65, 'B', TestFormatEnum::Value);
+    TEST_FORMAT("0x10 0x0", "{} {}", reinterpret_cast<const void *>(0x10), nullptr);
+
+    // The output is truncated to the buffer size
+    char buffer[8];
+    TEST_ASSERT_EQUAL(7, log_format::formatTo(buffer, sizeof(buffer), ESP_UTILS_LOG_FMT_STRING("{}"), "123456789"));
+    TEST_ASSERT_EQUAL_STRING("1234567", buffer);
+
+    ESP_UTILS_LOGD_FMT("Debug: {}, {:.2f}", 1, 0.5);
+    ESP_UTILS_LOGI_FMT("Info: {}, {:>8}", 2, "right");
+    ESP_UTILS_LOGW_FMT("Warning: {:#x}", 0xdead);
+    ESP_UTILS_LOGE_FMT("Error: no arguments");
+}
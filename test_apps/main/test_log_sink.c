@@ -0,0 +1,65 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <string.h>
+#include "unity.h"
+#define ESP_UTILS_LOG_TAG "TestSink"
+#include "esp_lib_utils.h"
+
+#if ESP_UTILS_CONF_LOG_ENABLE_SINK
+#define TEST_RING_SIZE  (256)
+
+static int test_sink_count = 0;
+
+static void test_sink_write(void *user_ctx, int level, const char *tag, const char *msg, size_t len)
+{
+    (void)user_ctx;
+    TEST_ASSERT_EQUAL_STRING(ESP_UTILS_LOG_TAG, tag);
+    TEST_ASSERT_TRUE(level >= ESP_UTILS_LOG_LEVEL_WARNING);
+    TEST_ASSERT_EQUAL('\n', msg[len - 1]);
+    test_sink_count++;
+}
+
+TEST_CASE("Test log sinks on C", "[utils][log][sink][C]")
+{
+    static char ring_buffer[TEST_RING_SIZE];
+    static esp_utils_log_ring_t ring;
+    static char read_buffer[TEST_RING_SIZE];
+
+    TEST_ASSERT_TRUE(esp_utils_log_ring_init(&ring, ring_buffer, sizeof(ring_buffer)));
+    esp_utils_log_sink_t ring_sink = ESP_UTILS_LOG_SINK_INIT(
+                                         esp_utils_log_ring_sink_write, &ring, ESP_UTILS_LOG_LEVEL_MASK_ALL
+                                     );
+    esp_utils_log_sink_t test_sink = ESP_UTILS_LOG_SINK_INIT(
+                                         test_sink_write, NULL, ESP_UTILS_LOG_LEVEL_MASK_FROM(ESP_UTILS_LOG_LEVEL_WARNING)
+                                     );
+    TEST_ASSERT_TRUE(esp_utils_log_sink_register(&ring_sink));
+    TEST_ASSERT_TRUE(esp_utils_log_sink_register(&test_sink));
+
+    test_sink_count = 0;
+    ESP_UTILS_LOGI("This is an info message");
+    ESP_UTILS_LOGW("This is a warning message");
+    ESP_UTILS_LOGE("This is an error message");
+    TEST_ASSERT_EQUAL(2, test_sink_count);
+
+    esp_utils_log_ring_read(&ring, read_buffer, sizeof(read_buffer));
+    TEST_ASSERT_NOT_NULL(strstr(read_buffer, "This is an info message"));
+    TEST_ASSERT_NOT_NULL(strstr(read_buffer, "This is an error message"));
+
+    // Overflow the ring, only the most recent complete lines should be kept
+    for (int i = 0; i < 32; i++) {
+        ESP_UTILS_LOGI("Ring line %d", i);
+    }
+    esp_utils_log_ring_read(&ring, read_buffer, sizeof(read_buffer));
+    TEST_ASSERT_NULL(strstr(read_buffer, "This is an info message"));
+    TEST_ASSERT_NOT_NULL(strstr(read_buffer, "Ring line 31\n"));
+    TEST_ASSERT_EQUAL('[', read_buffer[0]);
+    TEST_ASSERT_TRUE(esp_utils_log_ring_restore(&ring, ring_buffer, sizeof(ring_buffer)));
+
+    TEST_ASSERT_TRUE(esp_utils_log_sink_unregister(&test_sink));
+    TEST_ASSERT_TRUE(esp_utils_log_sink_unregister(&ring_sink));
+    TEST_ASSERT_FALSE(esp_utils_log_sink_unregister(&ring_sink));
+}
+#endif // ESP_UTILS_CONF_LOG_ENABLE_SINK
@@ -0,0 +1,92 @@
+/*
+ * SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include "unity.h"
+#define ESP_UTILS_LOG_TAG "TestTrace"
+#include "esp_lib_utils.h"
+
+#if ESP_UTILS_CONF_LOG_ENABLE_TRACE_RECORD
+using namespace esp_utils;
+
+class TraceTestClass {
+public:
+    int inner(int value)
+    {
+        ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+        return value * 2;
+    }
+
+    int outer(int value)
+    {
+        ESP_UTILS_LOG_TRACE_GUARD_WITH_THIS();
+
+        return inner(value) + 1;
+    }
+};
+
+static void test_trace_write(void *user_ctx, const char *data, size_t len)
+{
+    static_cast<std::string *>(user_ctx)->append(data, len);
+}
+
+TEST_CASE("Test log trace record on cpp", "[utils][log][trace][CPP]")
+{
+    log_trace::release();
+    {
+        ESP_UTILS_LOG_TRACE_GUARD();
+
+        TraceTestClass test_class;
+        TEST_ASSERT_EQUAL(7, test_class.outer(3));
+
+        std::thread thread([&test_class]() {
+            test_class.outer(1);
+        });
+        thread.join();
+
+        log_trace::setEnabled(false);
+        test_class.outer(2);
+        log_trace::setEnabled(true);
+    }
+
+    std::string json;
+    // 2 scopes for each `outer()` call and the test case scope, the disabled call is not recorded
+    TEST_ASSERT_EQUAL(5, log_trace::exportChromeTrace(test_trace_write, &json));
+    TEST_ASSERT_TRUE(json.find("\"traceEvents\"") != std::string::npos);
+    TEST_ASSERT_TRUE(json.find("\"name\":\"outer\",\"cat\":\"TestTrace\",\"ph\":\"X\"") != std::string::npos);
+    TEST_ASSERT_TRUE(json.find("\"name\":\"inner\"") != std::string::npos);
+    TEST_ASSERT_TRUE(json.find("\"tid\":2") != std::string::npos);
+    TEST_ASSERT_TRUE(json.find("\"this\":") != std::string::npos);
+    log_trace::exportChromeTrace(stdout);
+
+    log_trace::clear();
+    json.clear();
+    TEST_ASSERT_EQUAL(0, log_trace::exportChromeTrace(test_trace_write, &json));
+
+    // The records are exported in several batches, while another thread keeps recording
+    TraceTestClass test_class;
+    for (int i = 0; i < 12; i++) {
+        test_class.outer(i);
+    }
+    std::atomic<bool> running(true);
+    std::thread recorder([&running]() {
+        TraceTestClass recorder_class;
+        while (running) {
+            recorder_class.outer(0);
+        }
+    });
+    json.clear();
+    size_t exported = log_trace::exportChromeTrace(test_trace_write, &json);
+    running = false;
+    recorder.join();
+    TEST_ASSERT_GREATER_OR_EQUAL(std::min(24, ESP_UTILS_CONF_LOG_TRACE_RECORD_BUFFER_SIZE), exported);
+    TEST_ASSERT_TRUE(json.rfind("\n]}\n") == json.size() - 4);
+    log_trace::release();
+}
+#endif // ESP_UTILS_CONF_LOG_ENABLE_TRACE_RECORD
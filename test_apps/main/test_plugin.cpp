@@ -4,7 +4,17 @@
  * SPDX-License-Identifier: CC0-1.0
  */
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
 #include "unity.h"
 #if defined(ESP_UTILS_LOG_TAG)
 #undef ESP_UTILS_LOG_TAG
@@ -109,6 +119,16 @@ TEST_CASE("Test plugin functions on cpp", "[utils][plugin][CPP]")
         all_test_plugin_1_2[i]->stop();
     }
 
+    // Lookups by interned name or `std::string_view` give the same results
+    auto name_id = TestPluginRegistry::findNameId(std::string_view("Test_Plugin_1_2"));
+    TEST_ASSERT_TRUE_MESSAGE(name_id != esp_utils::PluginNameId::Invalid, "Failed to find Test_Plugin_1_2 name ID");
+    TEST_ASSERT_TRUE(TestPluginRegistry::internName("Test_Plugin_1_2") == name_id);
+    TEST_ASSERT_TRUE(TestPluginRegistry::getName(name_id) == "Test_Plugin_1_2");
+    TEST_ASSERT_TRUE(TestPluginRegistry::get(name_id) == test_plugin_1_2);
+    TEST_ASSERT_EQUAL(all_test_plugin_1_2.size(), TestPluginRegistry::getAll(name_id).size());
+    TEST_ASSERT_TRUE(TestPluginRegistry::findNameId("Test_Plugin_5") == esp_utils::PluginNameId::Invalid);
+    TEST_ASSERT_NULL(TestPluginRegistry::get(esp_utils::PluginNameId::Invalid));
+
     // 5. Statistics information
     std::cout << "\n5. Simplified statistics:" << std::endl;
     std::cout << "Total plugins: " << TestPluginRegistry::getPluginCount() << std::endl;
@@ -157,9 +177,13 @@ TEST_CASE("Test plugin functions on cpp", "[utils][plugin][CPP]")
     // Test remove all plugins with same name
     size_t removed_count = TestPluginRegistry::removeAllPlugins("Test_Plugin_1_2");
     std::cout << "Removed all Test_Plugin_1_2: " << removed_count << " plugins" << std::endl;
-    // Test remove by type
+    // Test remove by type, the type index must follow the removals
+    TEST_ASSERT_NOT_NULL_MESSAGE(TestPluginRegistry::get<TestPlugin4>(), "Failed to get TestPlugin4 by type");
+    TEST_ASSERT_NOT_NULL_MESSAGE(TestPluginRegistry::get<TestPlugin3>(), "Failed to get TestPlugin3 by type");
     bool removed_by_type = TestPluginRegistry::removePluginByType<TestPlugin3>();
     std::cout << "Removed TestPlugin3 by type: " << (removed_by_type ? "Success" : "Failed") << std::endl;
+    TEST_ASSERT_NULL_MESSAGE(TestPluginRegistry::get<TestPlugin3>(), "TestPlugin3 should be removed");
+    TEST_ASSERT_NOT_NULL_MESSAGE(TestPluginRegistry::get<TestPlugin4>(), "Failed to get TestPlugin4 by type");
     // Test remove specific plugin by name and type
     bool removed_specific = TestPluginRegistry::removeSpecificPlugin<TestPlugin4>("Test_Plugin_4");
     std::cout << "Removed specific TestPlugin4 with name Test_Plugin_4: " << (removed_specific ? "Success" : "Failed") << std::endl;
@@ -181,6 +205,656 @@ TEST_CASE("Test plugin functions on cpp", "[utils][plugin][CPP]")
     std::cout << "Cleared " << cleared_count << " plugins" << std::endl;
     // Final count after clearAllPlugins
     TEST_ASSERT_TRUE_MESSAGE(TestPluginRegistry::getPluginCount() == 0, "Plugin count should be 0 after clearAllPlugins");
+    // Release the storage of the registry as well (e.g. the interned names), for the memory leak check
+    TestPluginRegistry::reset();
+}
+
+class TestLazyPluginBase {
+public:
+    virtual ~TestLazyPluginBase() = default;
+};
+
+template <int N>
+class TestLazyPlugin : public TestLazyPluginBase {
+};
+
+using TestLazyPluginRegistry = esp_utils::PluginRegistry<TestLazyPluginBase>;
+
+TEST_CASE("Test plugin lazy creation on cpp", "[utils][plugin][CPP]")
+{
+    constexpr int THREAD_NUM = 4;
+    static std::atomic<int> slow_created(0);
+
+    // A slow factory runs only once, even if it is called by several threads
+    TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<0>>("Test_Lazy_Slow", []() {
+        slow_created++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return std::make_shared<TestLazyPlugin<0>>();
+    });
+    // A factory which waits for another thread using the registry
+    TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<1>>("Test_Lazy_Nested", []() {
+        std::shared_ptr<TestLazyPluginBase> other;
+        std::thread([&other]() {
+            other = TestLazyPluginRegistry::get("Test_Lazy_Other");
+        }).join();
+        return (other != nullptr) ? std::make_shared<TestLazyPlugin<1>>() : nullptr;
+    });
+    TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<2>>("Test_Lazy_Other", []() {
+        return std::make_shared<TestLazyPlugin<2>>();
+    });
+
+    std::vector<std::shared_ptr<TestLazyPlugin<0>>> instances(THREAD_NUM);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < THREAD_NUM; i++) {
+        threads.emplace_back([&instances, i]() {
+            instances[i] = TestLazyPluginRegistry::get<TestLazyPlugin<0>>();
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    TEST_ASSERT_EQUAL(1, slow_created.load());
+    for (const auto &instance : instances) {
+        TEST_ASSERT_NOT_NULL(instance.get());
+        TEST_ASSERT_TRUE(instance == instances[0]);
+    }
+
+    TEST_ASSERT_NOT_NULL(TestLazyPluginRegistry::get<TestLazyPlugin<1>>().get());
+
+    // A factory which doesn't fit inline is passed as a `std::function`, an empty `std::function` is no factory
+    std::array<int, 16> values = {};
+    values.back() = 3;
+    auto large_factory = [values]() -> std::shared_ptr<TestLazyPluginBase> {
+        return (values.back() == 3) ? std::make_shared<TestLazyPlugin<3>>() : nullptr;
+    };
+    static_assert(!TestLazyPluginRegistry::FactoryFunc::fits<decltype(large_factory)>, "The captures don't fit");
+    TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<3>>(
+        "Test_Lazy_Large", std::function<std::shared_ptr<TestLazyPluginBase>()>(large_factory)
+    );
+    TEST_ASSERT_NOT_NULL(TestLazyPluginRegistry::get<TestLazyPlugin<3>>().get());
+    TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<4>>(
+        "Test_Lazy_Empty", std::function<std::shared_ptr<TestLazyPluginBase>()>()
+    );
+    TEST_ASSERT_FALSE(TestLazyPluginRegistry::getPluginInfoByName("Test_Lazy_Empty")[0].hasFactory());
+    TEST_ASSERT_NULL(TestLazyPluginRegistry::get("Test_Lazy_Empty").get());
+
+    TestLazyPluginRegistry::reset();
+}
+
+TEST_CASE("Test plugin warm up on cpp", "[utils][plugin][CPP]")
+{
+    TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<0>>("Test_Warm_Up", []() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return std::make_shared<TestLazyPlugin<0>>();
+    });
+    TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<1>>("Test_Warm_Up", []() {
+        return std::make_shared<TestLazyPlugin<1>>();
+    });
+    TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<2>>("Test_Warm_Up_Failed", []() {
+        return nullptr;
+    });
+    TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<3>>("Test_Warm_Up_Later", []() {
+        return std::make_shared<TestLazyPlugin<3>>();
+    });
+    TestLazyPluginRegistry::registerSingleton<TestLazyPlugin<4>>(
+        "Test_Warm_Up_Singleton", std::make_shared<TestLazyPlugin<4>>()
+    );
+
+    auto results = TestLazyPluginRegistry::warmUp({"Test_Warm_Up", "Test_Warm_Up_Failed"}, 2);
+    TEST_ASSERT_EQUAL(3, results.size());
+    TEST_ASSERT_TRUE(results[0].name == "Test_Warm_Up");
+    TEST_ASSERT_TRUE(results[0].success);
+    TEST_ASSERT_GREATER_OR_EQUAL(10000, results[0].duration_us);
+    TEST_ASSERT_TRUE(results[1].success);
+    TEST_ASSERT_TRUE(results[2].name == "Test_Warm_Up_Failed");
+    TEST_ASSERT_FALSE(results[2].success);
+    TEST_ASSERT_FALSE(TestLazyPluginRegistry::getPluginInfoByName("Test_Warm_Up_Later")[0].hasInstance());
+
+    // Created plugins are skipped, the failed one is tried again
+    results = TestLazyPluginRegistry::warmUp();
+    TEST_ASSERT_EQUAL(2, results.size());
+    TEST_ASSERT_TRUE(results[0].name == "Test_Warm_Up_Failed");
+    TEST_ASSERT_TRUE(results[1].name == "Test_Warm_Up_Later");
+    TEST_ASSERT_TRUE(results[1].success);
+    for (const auto &result : results) {
+        std::cout << result.name << " (" << result.type_name << "): " << result.duration_us << " us" << std::endl;
+    }
+
+    TestLazyPluginRegistry::reset();
+}
+
+TEST_CASE("Test plugin handle on cpp", "[utils][plugin][CPP]")
+{
+    TestLazyPluginRegistry::Handle<TestLazyPlugin<0>> handle;
+    TEST_ASSERT_FALSE(handle);
+
+    TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<0>>("Test_Handle", []() {
+        return std::make_shared<TestLazyPlugin<0>>();
+    });
+    TEST_ASSERT_TRUE(handle);
+    auto instance = TestLazyPluginRegistry::get<TestLazyPlugin<0>>();
+    TEST_ASSERT_EQUAL_PTR(instance.get(), handle.get());
+
+    // Modifying other plugins only resolves the same instance again
+    TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<1>>("Test_Handle_Other", []() {
+        return std::make_shared<TestLazyPlugin<1>>();
+    });
+    TEST_ASSERT_EQUAL_PTR(instance.get(), handle.get());
+
+    // Interning a name doesn't modify any plugin, so the handles don't need to resolve again
+    auto generation = TestLazyPluginRegistry::getGeneration();
+    {
+        auto view = TestLazyPluginRegistry::view();
+        TestLazyPluginRegistry::internName("Test_Handle_Interned");
+    }
+    TestLazyPluginRegistry::internName("Test_Handle_Interned_Again");
+    TEST_ASSERT_EQUAL(generation, TestLazyPluginRegistry::getGeneration());
+    TEST_ASSERT_TRUE(TestLazyPluginRegistry::findNameId("Test_Handle_Interned") != esp_utils::PluginNameId::Invalid);
+    TEST_ASSERT_EQUAL_PTR(instance.get(), handle.get());
+
+    TEST_ASSERT_TRUE(TestLazyPluginRegistry::removePluginByType<TestLazyPlugin<0>>());
+    TEST_ASSERT_NULL(handle.get());
+
+    TestLazyPluginRegistry::registerSingleton<TestLazyPlugin<0>>("Test_Handle", std::make_shared<TestLazyPlugin<0>>());
+    TEST_ASSERT_NOT_NULL(handle.get());
+    TEST_ASSERT_TRUE(handle.get() != instance.get());
+
+    TestLazyPluginRegistry::reset();
+    TEST_ASSERT_FALSE(handle);
+}
+
+TEST_CASE("Test plugin views on cpp", "[utils][plugin][CPP]")
+{
+    TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<0>>("Test_View", []() {
+        return std::make_shared<TestLazyPlugin<0>>();
+    });
+    TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<1>>("Test_View_Other", []() {
+        return std::make_shared<TestLazyPlugin<1>>();
+    });
+    TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<2>>("Test_View", []() {
+        return std::make_shared<TestLazyPlugin<2>>();
+    });
+
+    {
+        auto view = TestLazyPluginRegistry::view();
+        // The view is not affected by later modifications
+        TestLazyPluginRegistry::removeAllPlugins("Test_View");
+        TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<3>>("Test_View", []() {
+            return std::make_shared<TestLazyPlugin<3>>();
+        });
+        TEST_ASSERT_EQUAL(2, TestLazyPluginRegistry::getPluginCount());
+
+        TEST_ASSERT_EQUAL(3, view.size());
+        size_t count = 0;
+        for (const auto &plugin : view) {
+            TEST_ASSERT_TRUE(&plugin == &view[count]);
+            count++;
+        }
+        TEST_ASSERT_EQUAL(3, count);
+
+        auto range = view.byName("Test_View");
+        TEST_ASSERT_EQUAL(2, range.size());
+        auto it = range.begin();
+        TEST_ASSERT_TRUE(it->type_idx == std::type_index(typeid(TestLazyPlugin<0>)));
+        ++it;
+        TEST_ASSERT_TRUE(it->type_idx == std::type_index(typeid(TestLazyPlugin<2>)));
+        TEST_ASSERT_TRUE(++it == range.end());
+        TEST_ASSERT_TRUE(view.byName("Test_View_Missing").empty());
+
+        auto found = view.findIf([](const auto & plugin) {
+            return plugin.name == "Test_View_Other";
+        });
+        TEST_ASSERT_TRUE(found != view.end());
+        TEST_ASSERT_EQUAL(1, found - view.begin());
+    }
+    TEST_ASSERT_EQUAL(1, TestLazyPluginRegistry::view().byName("Test_View").size());
+
+    {
+        // The iterators of `begin()` keep their snapshot, and `end()` is the end of any snapshot
+        auto it = TestLazyPluginRegistry::begin();
+        TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<4>>("Test_View_Later", []() {
+            return std::make_shared<TestLazyPlugin<4>>();
+        });
+        TestLazyPluginRegistry::evictIdle();
+        size_t count = 0;
+        for (; it != TestLazyPluginRegistry::end(); ++it) {
+            TEST_ASSERT_TRUE(it->name != "Test_View_Later");
+            count++;
+        }
+        TEST_ASSERT_EQUAL(2, count);
+        TEST_ASSERT_EQUAL(3, TestLazyPluginRegistry::end() - TestLazyPluginRegistry::begin());
+        TEST_ASSERT_TRUE(TestLazyPluginRegistry::findIf([](const auto & plugin) {
+            return plugin.name == "Test_View_Later";
+        }) != TestLazyPluginRegistry::end());
+        TestLazyPluginRegistry::removeAllPlugins("Test_View_Later");
+    }
+
+    // A batch is published at once
+    auto generation = TestLazyPluginRegistry::getGeneration();
+    TestLazyPluginRegistry::registerBatch([]() {
+        TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<4>>("Test_View_Batch", []() {
+            return std::make_shared<TestLazyPlugin<4>>();
+        });
+        TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<5>>("Test_View_Batch", []() {
+            return std::make_shared<TestLazyPlugin<5>>();
+        });
+        TEST_ASSERT_NULL(TestLazyPluginRegistry::get("Test_View_Batch").get());
+    });
+    TEST_ASSERT_EQUAL(generation + 1, TestLazyPluginRegistry::getGeneration());
+    TEST_ASSERT_EQUAL(2, TestLazyPluginRegistry::view().byName("Test_View_Batch").size());
+
+    TestLazyPluginRegistry::reset();
+}
+
+TEST_CASE("Test plugin idle eviction on cpp", "[utils][plugin][CPP]")
+{
+    static std::atomic<int> created(0);
+    TestLazyPluginRegistry::registerPlugin<TestLazyPlugin<0>>("Test_Evict", []() {
+        created++;
+        return std::make_shared<TestLazyPlugin<0>>();
+    });
+    TestLazyPluginRegistry::registerSingleton<TestLazyPlugin<1>>(
+        "Test_Evict_Singleton", std::make_shared<TestLazyPlugin<1>>()
+    );
+
+    // An instance used outside of the registry is kept
+    auto instance = TestLazyPluginRegistry::get<TestLazyPlugin<0>>();
+    TEST_ASSERT_EQUAL(0, TestLazyPluginRegistry::evictIdle());
+    instance.reset();
+    TEST_ASSERT_EQUAL(1, TestLazyPluginRegistry::evictIdle());
+    TEST_ASSERT_FALSE(TestLazyPluginRegistry::getPluginInfoByName("Test_Evict")[0].hasInstance());
+    TEST_ASSERT_TRUE(TestLazyPluginRegistry::getPluginInfoByName("Test_Evict_Singleton")[0].hasInstance());
+
+    // It is created again on demand, and only released after being idle for long enough
+    TEST_ASSERT_NOT_NULL(TestLazyPluginRegistry::get<TestLazyPlugin<0>>().get());
+    TEST_ASSERT_EQUAL(2, created.load());
+    TEST_ASSERT_EQUAL(0, TestLazyPluginRegistry::evictIdle(std::chrono::milliseconds(50)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    TEST_ASSERT_EQUAL(1, TestLazyPluginRegistry::evictIdle(std::chrono::milliseconds(50)));
+    TEST_ASSERT_FALSE(TestLazyPluginRegistry::getPluginInfoByName("Test_Evict")[0].hasInstance());
+
+    // An evicted instance which a reader may still use is reused, instead of creating a second one
+    TEST_ASSERT_NOT_NULL(TestLazyPluginRegistry::get<TestLazyPlugin<0>>().get());
+    {
+        auto view = TestLazyPluginRegistry::view();
+        TEST_ASSERT_EQUAL(1, TestLazyPluginRegistry::evictIdle());
+        auto pinned = view.byName("Test_Evict").begin()->getInstance();
+        TEST_ASSERT_TRUE(TestLazyPluginRegistry::get<TestLazyPlugin<0>>() == pinned);
+    }
+    TEST_ASSERT_EQUAL(3, created.load());
+
+    TestLazyPluginRegistry::reset();
+}
+
+class TestDependencyPluginBase {
+public:
+    virtual ~TestDependencyPluginBase() = default;
+};
+
+using TestDependencyPluginRegistry = esp_utils::PluginRegistry<TestDependencyPluginBase>;
+
+static std::mutex test_dependency_mutex;
+static std::vector<std::string> test_dependency_created;
+
+template <int N>
+class TestDependencyPlugin : public TestDependencyPluginBase {
+public:
+    TestDependencyPlugin()
+    {
+        std::lock_guard<std::mutex> lock(test_dependency_mutex);
+        test_dependency_created.push_back("Test_Dependency_" + std::to_string(N));
+    }
+};
+
+class TestDependencySensor : public TestDependencyPluginBase {
+public:
+    TestDependencySensor()
+    {
+        std::lock_guard<std::mutex> lock(test_dependency_mutex);
+        test_dependency_created.push_back("Test_Dependency_Sensor");
+    }
+};
+
+ESP_UTILS_REGISTER_PLUGIN_WITH_DEPENDENCIES(
+    TestDependencyPluginBase, TestDependencySensor, "Test_Dependency_Sensor", "Test_Dependency_1"
+)
+
+template <int N>
+static void registerTestDependencyPlugin(const std::vector<std::string_view> &dependencies, bool success = true)
+{
+    TestDependencyPluginRegistry::registerPlugin<TestDependencyPlugin<N>>("Test_Dependency_" + std::to_string(N),
+    [success]() {
+        return success ? std::make_shared<TestDependencyPlugin<N>>() : nullptr;
+    }, dependencies);
+}
+
+static size_t getTestDependencyOrder(const std::string &name)
+{
+    auto it = std::find(test_dependency_created.begin(), test_dependency_created.end(), name);
+    TEST_ASSERT_TRUE_MESSAGE(it != test_dependency_created.end(), name.c_str());
+    return it - test_dependency_created.begin();
+}
+
+TEST_CASE("Test plugin dependencies on cpp", "[utils][plugin][CPP]")
+{
+    using Status = esp_utils::PluginWarmUpStatus;
+
+    // Power <- Bus <- Display, Bus <- Sensor, the dependencies can be registered later
+    registerTestDependencyPlugin<2>({"Test_Dependency_1"});
+    registerTestDependencyPlugin<1>({"Test_Dependency_0"});
+    registerTestDependencyPlugin<0>({});
+    // Cycle
+    registerTestDependencyPlugin<3>({"Test_Dependency_4"});
+    registerTestDependencyPlugin<4>({"Test_Dependency_3"});
+    // Missing and failed dependencies
+    registerTestDependencyPlugin<5>({"Test_Dependency_Missing"});
+    registerTestDependencyPlugin<6>({}, false);
+    registerTestDependencyPlugin<7>({"Test_Dependency_6"});
+
+    // The dependencies of the selected plugins are created first, even if they are not selected
+    auto results = TestDependencyPluginRegistry::warmUp({"Test_Dependency_2"}, 2);
+    TEST_ASSERT_EQUAL(3, results.size());
+    for (const auto &result : results) {
+        TEST_ASSERT_TRUE(result.status == Status::Created);
+    }
+    TEST_ASSERT_EQUAL(3, test_dependency_created.size());
+    TEST_ASSERT_LESS_THAN(getTestDependencyOrder("Test_Dependency_1"), getTestDependencyOrder("Test_Dependency_0"));
+    TEST_ASSERT_LESS_THAN(getTestDependencyOrder("Test_Dependency_2"), getTestDependencyOrder("Test_Dependency_1"));
+
+    results = TestDependencyPluginRegistry::warmUp(2);
+    std::unordered_map<std::string, Status> status;
+    for (const auto &result : results) {
+        status[result.name] = result.status;
+    }
+    TEST_ASSERT_EQUAL(6, results.size());
+    TEST_ASSERT_TRUE(status["Test_Dependency_Sensor"] == Status::Created);
+    TEST_ASSERT_TRUE(status["Test_Dependency_3"] == Status::DependencyCycle);
+    TEST_ASSERT_TRUE(status["Test_Dependency_4"] == Status::DependencyCycle);
+    TEST_ASSERT_TRUE(status["Test_Dependency_5"] == Status::MissingDependency);
+    TEST_ASSERT_TRUE(status["Test_Dependency_6"] == Status::Failed);
+    TEST_ASSERT_TRUE(status["Test_Dependency_7"] == Status::DependencyFailed);
+    TEST_ASSERT_LESS_THAN(
+        getTestDependencyOrder("Test_Dependency_Sensor"), getTestDependencyOrder("Test_Dependency_1")
+    );
+    TEST_ASSERT_EQUAL(4, test_dependency_created.size());
+
+    // A singleton replacing a plugin keeps its dependencies
+    TestDependencyPluginRegistry::registerSingleton("Test_Dependency_5", std::make_shared<TestDependencyPlugin<5>>());
+    auto info = TestDependencyPluginRegistry::getPluginInfoByName("Test_Dependency_5");
+    TEST_ASSERT_EQUAL(1, info.size());
+    TEST_ASSERT_EQUAL(1, info[0].dependencies.size());
+
+    TestDependencyPluginRegistry::reset();
+}
+
+class TestStaticPluginBase {
+public:
+    virtual ~TestStaticPluginBase() = default;
+
+    virtual int id() const = 0;
+};
+
+ESP_UTILS_DECLARE_STATIC_PLUGINS(TestStaticPluginBase);
+
+template <int N>
+class TestStaticPlugin : public TestStaticPluginBase {
+public:
+    int id() const override
+    {
+        return N;
+    }
+};
+
+static std::shared_ptr<TestStaticPluginBase> createTestStaticPlugin()
+{
+    return std::make_shared<TestStaticPlugin<2>>();
+}
+
+ESP_UTILS_DEFINE_STATIC_PLUGINS(TestStaticPluginBase,
+                                esp_utils::makeStaticPlugin<TestStaticPluginBase, TestStaticPlugin<0>>("Test_Static_0"),
+                                esp_utils::makeStaticPlugin<TestStaticPluginBase, TestStaticPlugin<1>>("Test_Static_1"),
+                                esp_utils::makeStaticPlugin<TestStaticPluginBase, TestStaticPlugin<2>>(
+                                    "Test_Static_1", &createTestStaticPlugin
+                                ),
+                                esp_utils::makeStaticPlugin<TestStaticPluginBase, TestStaticPlugin<0>>("Test_Static_0")
+                               )
+
+using TestStaticPluginRegistry = esp_utils::PluginRegistry<TestStaticPluginBase>;
+
+TEST_CASE("Test plugin static table on cpp", "[utils][plugin][CPP]")
+{
+    // The duplicated descriptor is skipped, and no instance is created until it is requested
+    TEST_ASSERT_EQUAL(3, TestStaticPluginRegistry::getPluginCount());
+    TestStaticPluginRegistry::forEach([](const auto & plugin) {
+        TEST_ASSERT_TRUE(plugin.hasFactory());
+        TEST_ASSERT_FALSE(plugin.hasInstance());
+    });
+
+    {
+        // The type name converts to the cached `std::string`
+        auto view = TestStaticPluginRegistry::view();
+        const std::string &type_name = view[0].type_name;
+        TEST_ASSERT_TRUE(type_name == "TestStaticPlugin<0>");
+        TEST_ASSERT_TRUE(&type_name == &view[0].type_name.str());
+        TEST_ASSERT_TRUE(&type_name == &TestStaticPluginRegistry::getRealTypeName<TestStaticPlugin<0>>());
+        TEST_ASSERT_TRUE(view[1].type_name.str() != type_name);
+        TEST_ASSERT_EQUAL_STRING("TestStaticPlugin<0>", view[0].type_name.c_str());
+    }
+    TEST_ASSERT_TRUE(TestStaticPluginRegistry::getRealTypeName<TestStaticPlugin<2>>() == "TestStaticPlugin<2>");
+
+    auto plugin_0 = TestStaticPluginRegistry::get<TestStaticPlugin<0>>();
+    TEST_ASSERT_NOT_NULL(plugin_0.get());
+    TEST_ASSERT_EQUAL(0, plugin_0->id());
+    TEST_ASSERT_TRUE(TestStaticPluginRegistry::get("Test_Static_0") == plugin_0);
+    auto plugins_1 = TestStaticPluginRegistry::getAll("Test_Static_1");
+    TEST_ASSERT_EQUAL(2, plugins_1.size());
+    TEST_ASSERT_EQUAL(1, plugins_1[0]->id());
+    TEST_ASSERT_EQUAL(2, plugins_1[1]->id());
+
+    // Static plugins are managed like the other ones
+    TestStaticPluginRegistry::registerPlugin<TestStaticPlugin<0>>("Test_Static_0", []() {
+        return std::make_shared<TestStaticPlugin<0>>();
+    });
+    TEST_ASSERT_EQUAL(3, TestStaticPluginRegistry::getPluginCount());
+    TEST_ASSERT_TRUE(TestStaticPluginRegistry::removePluginByType<TestStaticPlugin<2>>());
+    TEST_ASSERT_EQUAL(2, TestStaticPluginRegistry::reset());
+}
+
+// Counts the bytes allocated by the registry storage, on top of the general allocator
+static std::atomic<size_t> test_allocator_bytes(0);
+
+template <typename T>
+struct TestCountingAllocator : public esp_utils::GeneralMemoryAllocator<T> {
+    using value_type = T;
+
+    TestCountingAllocator() = default;
+
+    template <typename U>
+    TestCountingAllocator(const TestCountingAllocator<U> &) {}
+
+    T *allocate(std::size_t n)
+    {
+        test_allocator_bytes += n * sizeof(T);
+        return esp_utils::GeneralMemoryAllocator<T>::allocate(n);
+    }
+
+    void deallocate(T *p, std::size_t n)
+    {
+        test_allocator_bytes -= n * sizeof(T);
+        esp_utils::GeneralMemoryAllocator<T>::deallocate(p, n);
+    }
+
+    template <typename U>
+    struct rebind {
+        using other = TestCountingAllocator<U>;
+    };
+};
+
+using TestAllocatorPluginRegistry =
+    esp_utils::PluginRegistry<TestLazyPluginBase, TestCountingAllocator<TestLazyPluginBase>>;
+
+TEST_CASE("Test plugin allocator on cpp", "[utils][plugin][CPP]")
+{
+    auto bytes = test_allocator_bytes.load();
+
+    TestAllocatorPluginRegistry::registerPlugin<TestLazyPlugin<0>>("Test_Allocator_0", []() {
+        return std::make_shared<TestLazyPlugin<0>>();
+    });
+    TestAllocatorPluginRegistry::registerPlugin<TestLazyPlugin<1>>("Test_Allocator_1", []() {
+        return std::make_shared<TestLazyPlugin<1>>();
+    }, {"Test_Allocator_0"});
+    TEST_ASSERT_GREATER_THAN(bytes, test_allocator_bytes.load());
+
+    // The registry is separate from the one with the default allocator
+    TEST_ASSERT_EQUAL(2, TestAllocatorPluginRegistry::getPluginCount());
+    TEST_ASSERT_NULL(TestLazyPluginRegistry::get("Test_Allocator_0").get());
+
+    auto plugin = TestAllocatorPluginRegistry::get<TestLazyPlugin<1>>();
+    TEST_ASSERT_NOT_NULL(plugin.get());
+    TEST_ASSERT_TRUE(TestAllocatorPluginRegistry::get("Test_Allocator_1") == plugin);
+    TestAllocatorPluginRegistry::Handle<TestLazyPlugin<1>> handle;
+    TEST_ASSERT_TRUE(handle.get() == plugin.get());
+    {
+        auto view = TestAllocatorPluginRegistry::view();
+        TEST_ASSERT_EQUAL(1, view.byName("Test_Allocator_0").size());
+        TEST_ASSERT_TRUE(view[1].name == "Test_Allocator_1");
+        TEST_ASSERT_EQUAL(1, view[1].dependencies.size());
+    }
+    auto names = TestAllocatorPluginRegistry::listRegisteredNames();
+    TEST_ASSERT_EQUAL(2, names.size());
+    TEST_ASSERT_TRUE(names[0] == "Test_Allocator_0");
+    // Only the dependency is left to create
+    TEST_ASSERT_EQUAL(1, TestAllocatorPluginRegistry::warmUp().size());
+
+    TEST_ASSERT_EQUAL(2, TestAllocatorPluginRegistry::reset());
+    // Only the empty snapshot is left
+    TEST_ASSERT_LESS_THAN(bytes + 256, test_allocator_bytes.load());
+    TEST_ASSERT_NULL(TestAllocatorPluginRegistry::get("Test_Allocator_1").get());
+}
+
+class TestScopedPluginBase {
+public:
+    virtual ~TestScopedPluginBase() = default;
+};
+
+static std::atomic<int> test_scoped_created(0);
+static std::atomic<int> test_scoped_alive(0);
+
+template <int N>
+class TestScopedPlugin : public TestScopedPluginBase {
+public:
+    TestScopedPlugin()
+    {
+        test_scoped_created++;
+        test_scoped_alive++;
+    }
+
+    ~TestScopedPlugin() override
+    {
+        test_scoped_alive--;
+    }
+};
+
+using TestScopedPluginRegistry = esp_utils::PluginRegistry<TestScopedPluginBase>;
+using TestThreadPlugin = TestScopedPlugin<0>;
+using TestCorePlugin = TestScopedPlugin<1>;
+
+ESP_UTILS_REGISTER_PLUGIN_WITH_SCOPE(
+    TestScopedPluginBase, TestThreadPlugin, "Test_Scope_Thread", esp_utils::PluginScope::PerThread
+)
+
+TEST_CASE("Test plugin scope on cpp", "[utils][plugin][CPP]")
+{
+    constexpr int THREAD_NUM = 4;
+
+    TestScopedPluginRegistry::registerPlugin<TestCorePlugin>("Test_Scope_Core", []() {
+        return std::make_shared<TestCorePlugin>();
+    }, esp_utils::PluginScope::PerCore);
+
+    // Each thread gets its own instance, created on its first lookup
+    auto main_instance = TestScopedPluginRegistry::get<TestThreadPlugin>();
+    TEST_ASSERT_NOT_NULL(main_instance.get());
+    TEST_ASSERT_TRUE(TestScopedPluginRegistry::get("Test_Scope_Thread") == main_instance);
+    std::vector<std::shared_ptr<TestScopedPluginBase>> instances(THREAD_NUM);
+    std::vector<TestScopedPluginBase *> handle_instances(THREAD_NUM);
+    std::vector<std::thread> threads;
+    std::atomic<int> ready_num(0);
+    for (int i = 0; i < THREAD_NUM; i++) {
+        // The results are checked by the main thread, Unity can't fail a test from another thread
+        threads.emplace_back([&instances, &handle_instances, &ready_num, i]() {
+            TestScopedPluginRegistry::Handle<TestThreadPlugin> handle;
+            instances[i] = TestScopedPluginRegistry::get("Test_Scope_Thread");
+            handle_instances[i] = handle.get();
+            // Keep all threads alive, so they all run at the same time
+            ready_num++;
+            while (ready_num < THREAD_NUM) {
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    TEST_ASSERT_EQUAL(THREAD_NUM + 1, test_scoped_created.load());
+    for (int i = 0; i < THREAD_NUM; i++) {
+        TEST_ASSERT_NOT_NULL(instances[i].get());
+        TEST_ASSERT_TRUE(handle_instances[i] == instances[i].get());
+        TEST_ASSERT_TRUE(instances[i] != main_instance);
+        for (int j = 0; j < i; j++) {
+            TEST_ASSERT_TRUE(instances[i] != instances[j]);
+        }
+    }
+
+    // Scoped instances are not created ahead of use
+    TEST_ASSERT_EQUAL(0, TestScopedPluginRegistry::warmUp().size());
+
+    // The registry released the instances of the exited threads
+    instances.clear();
+    TEST_ASSERT_EQUAL(1, test_scoped_alive.load());
+    TEST_ASSERT_EQUAL(0, TestScopedPluginRegistry::evictIdle());
+
+    // A per-thread instance which has been looked up since the previous call is not idle
+    auto main_raw = main_instance.get();
+    main_instance.reset();
+    TEST_ASSERT_TRUE(TestScopedPluginRegistry::get<TestThreadPlugin>().get() == main_raw);
+    TEST_ASSERT_EQUAL(0, TestScopedPluginRegistry::evictIdle(std::chrono::hours(1)));
+    main_instance = TestScopedPluginRegistry::get<TestThreadPlugin>();
+    TEST_ASSERT_TRUE(main_instance.get() == main_raw);
+
+    // A singleton can't replace a scoped plugin
+    TEST_ASSERT_FALSE(
+        TestScopedPluginRegistry::registerSingleton("Test_Scope_Thread", std::make_shared<TestThreadPlugin>())
+    );
+    TEST_ASSERT_TRUE(TestScopedPluginRegistry::view()[0].scope == esp_utils::PluginScope::PerThread);
+    TEST_ASSERT_TRUE(TestScopedPluginRegistry::get<TestThreadPlugin>() == main_instance);
+
+    // Each core gets its own instance, so there are at most as many instances as cores
+    test_scoped_created = 0;
+    std::vector<std::shared_ptr<TestCorePlugin>> core_instances;
+    std::vector<TestCorePlugin *> core_handle_instances;
+    TestScopedPluginRegistry::Handle<TestCorePlugin> core_handle;
+    for (int i = 0; i < 16; i++) {
+        core_instances.push_back(TestScopedPluginRegistry::get<TestCorePlugin>());
+        TEST_ASSERT_NOT_NULL(core_instances.back().get());
+        core_handle_instances.push_back(core_handle.get());
+    }
+    std::sort(core_instances.begin(), core_instances.end());
+    core_instances.erase(std::unique(core_instances.begin(), core_instances.end()), core_instances.end());
+    TEST_ASSERT_EQUAL(test_scoped_created.load(), core_instances.size());
+    // The handle gives the instance of the core it runs on, created by the same factory
+    for (auto instance : core_handle_instances) {
+        TEST_ASSERT_NOT_NULL(instance);
+    }
+    TEST_ASSERT_LESS_OR_EQUAL(esp_utils::detail::getPluginCoreNum(), test_scoped_created.load());
+    core_handle.reset();
+
+    core_instances.clear();
+    main_instance.reset();
+    TEST_ASSERT_EQUAL(test_scoped_created.load() + 1, TestScopedPluginRegistry::evictIdle());
+    TEST_ASSERT_FALSE(TestScopedPluginRegistry::view()[0].hasInstance());
+    TEST_ASSERT_FALSE(TestScopedPluginRegistry::view()[1].hasInstance());
+
+    TEST_ASSERT_EQUAL(2, TestScopedPluginRegistry::reset());
 }
 
 #endif /* ESP_UTILS_CONF_PLUGIN_SUPPORT */
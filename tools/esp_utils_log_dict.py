@@ -0,0 +1,404 @@
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Host side of the dictionary-based log encoding (`ESP_UTILS_CONF_LOG_ENABLE_DICT`).
+
+Extract the call-site dictionary from the application ELF file:
+    python esp_utils_log_dict.py extract build/app.elf -o build/esp_utils_log_dict.json
+
+Decode a captured stream (raw text outside of frames is passed through unchanged):
+    python esp_utils_log_dict.py decode --dict build/esp_utils_log_dict.json capture.bin
+    python esp_utils_log_dict.py decode --elf build/app.elf --port /dev/ttyUSB0 --baud 115200
+
+Host executables linked as PIE are supported on x86_64, other targets should be linked without PIE.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+SYNC = 0xA5
+ESCAPE = 0xDB
+ESCAPE_XOR = 0x20
+SITE_MAGIC = 0x4C4F4744
+SITE_SYMBOL = 'esp_utils_log_dict_site'
+ANCHOR_SYMBOL = 'esp_utils_log_dict_anchor'
+FLAG_RUNTIME_TAG = 1 << 0
+LEVEL_CHARS = 'DIWE'
+
+SHT_SYMTAB = 2
+SHT_RELA = 4
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+EM_X86_64 = 62
+R_X86_64_RELATIVE = 8
+
+# Same conversion syntax as the encoder in `esp_utils_log_dict.c`
+CONVERSION_RE = re.compile(r"%([-+ #0']*)(\*|\d+)?(?:\.(\*|\d*))?(hh|ll|[hljztLq])?([diuoxXcpfFeEgGaAsn%])")
+
+
+class ElfFile:
+    """Minimal ELF reader, only what is needed to read the call-site descriptors"""
+
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF':
+            raise ValueError('{} is not an ELF file'.format(path))
+        self.is_64 = self.data[4] == 2
+        self.endian = '<' if self.data[5] == 1 else '>'
+        self.ptr_size = 8 if self.is_64 else 4
+        self._parse_header()
+        self._parse_sections()
+        self._parse_relocations()
+
+    def _unpack(self, fmt, offset):
+        return struct.unpack_from(self.endian + fmt, self.data, offset)
+
+    def _parse_header(self):
+        if self.is_64:
+            (self.machine,) = self._unpack('H', 18)
+            (self.shoff,) = self._unpack('Q', 40)
+            self.shentsize, self.shnum, self.shstrndx = self._unpack('HHH', 58)
+        else:
+            (self.machine,) = self._unpack('H', 18)
+            (self.shoff,) = self._unpack('I', 32)
+            self.shentsize, self.shnum, self.shstrndx = self._unpack('HHH', 46)
+
+    def _parse_sections(self):
+        self.sections = []
+        for i in range(self.shnum):
+            offset = self.shoff + i * self.shentsize
+            if self.is_64:
+                name, sh_type, flags, addr, sh_offset, size, link, _, _, entsize = self._unpack('IIQQQQIIQQ', offset)
+            else:
+                name, sh_type, flags, addr, sh_offset, size, link, _, _, entsize = self._unpack('IIIIIIIIII', offset)
+            self.sections.append({
+                'name': name, 'type': sh_type, 'flags': flags, 'addr': addr, 'offset': sh_offset, 'size': size,
+                'link': link, 'entsize': entsize,
+            })
+
+    def _parse_relocations(self):
+        # Pointers of PIE executables are stored in relocations instead of the section data
+        self.relative = {}
+        if not self.is_64 or self.machine != EM_X86_64:
+            return
+        for section in self.sections:
+            if section['type'] != SHT_RELA:
+                continue
+            for offset in range(section['offset'], section['offset'] + section['size'], 24):
+                r_offset, r_info, r_addend = self._unpack('QQq', offset)
+                if (r_info & 0xFFFFFFFF) == R_X86_64_RELATIVE:
+                    self.relative[r_offset] = r_addend
+
+    def _string(self, offset):
+        end = self.data.index(b'\0', offset)
+        return self.data[offset:end].decode('utf-8', errors='replace')
+
+    def symbols(self):
+        for section in self.sections:
+            if section['type'] != SHT_SYMTAB:
+                continue
+            strtab = self.sections[section['link']]
+            entsize = section['entsize'] or (24 if self.is_64 else 16)
+            for offset in range(section['offset'], section['offset'] + section['size'], entsize):
+                if self.is_64:
+                    name, _, _, _, value, size = self._unpack('IBBHQQ', offset)
+                else:
+                    name, value, size, _, _, _ = self._unpack('IIIBBH', offset)
+                if name != 0:
+                    yield self._string(strtab['offset'] + name), value, size
+
+    def _file_offset(self, addr, size):
+        for section in self.sections:
+            if (section['flags'] & SHF_ALLOC) and section['type'] != SHT_NOBITS and \
+                    section['addr'] <= addr and addr + size <= section['addr'] + section['size']:
+                return section['offset'] + addr - section['addr']
+        return None
+
+    def read(self, addr, size):
+        offset = self._file_offset(addr, size)
+        if offset is None:
+            return None
+        return self.data[offset:offset + size]
+
+    def read_ptr(self, addr):
+        if addr in self.relative:
+            return self.relative[addr]
+        raw = self.read(addr, self.ptr_size)
+        if raw is None:
+            return None
+        return struct.unpack(self.endian + ('Q' if self.is_64 else 'I'), raw)[0]
+
+    def read_cstring(self, addr):
+        if not addr:
+            return None
+        offset = self._file_offset(addr, 1)
+        if offset is None:
+            return None
+        return self._string(offset)
+
+
+def extract_dictionary(elf_path):
+    elf = ElfFile(elf_path)
+    symbols = list(elf.symbols())
+    anchor = next((value for name, value, _ in symbols if name == ANCHOR_SYMBOL), None)
+    if anchor is None:
+        raise ValueError('Symbol `{}` not found, is the log dictionary enabled?'.format(ANCHOR_SYMBOL))
+
+    # magic, level, flags, line, then 4 pointers aligned to the pointer size
+    ptr_base = (12 + elf.ptr_size - 1) // elf.ptr_size * elf.ptr_size
+    sites = {}
+    for name, addr, _ in symbols:
+        if SITE_SYMBOL not in name or name == ANCHOR_SYMBOL:
+            continue
+        header = elf.read(addr, 12)
+        if header is None:
+            continue
+        magic, level, flags, line = struct.unpack(elf.endian + 'IHHI', header)
+        if magic != SITE_MAGIC:
+            continue
+        tag, file, func, fmt = [elf.read_cstring(elf.read_ptr(addr + ptr_base + i * elf.ptr_size)) for i in range(4)]
+        sites[str((addr - anchor) // 4)] = {
+            'level': level, 'flags': flags, 'line': line, 'tag': tag, 'file': file, 'func': func, 'format': fmt or '',
+        }
+
+    return {'version': 1, 'elf': os.path.basename(elf_path), 'sites': sites}
+
+
+class PayloadReader:
+
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def varint(self):
+        value = 0
+        shift = 0
+        while True:
+            if self.pos >= len(self.data):
+                raise EOFError
+            byte = self.data[self.pos]
+            self.pos += 1
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value
+
+    def zigzag(self):
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+    def double(self):
+        if self.pos + 8 > len(self.data):
+            raise EOFError
+        (value,) = struct.unpack_from('<d', self.data, self.pos)
+        self.pos += 8
+        return value
+
+    def string(self):
+        length = self.varint()
+        if self.pos + length > len(self.data):
+            raise EOFError
+        value = self.data[self.pos:self.pos + length].decode('utf-8', errors='replace')
+        self.pos += length
+        return value
+
+
+def format_message(fmt, reader):
+    """Render `fmt` with arguments read from the payload, missing arguments are shown as `<?>`"""
+    out = []
+    last = 0
+    truncated = False
+    for match in CONVERSION_RE.finditer(fmt):
+        out.append(fmt[last:match.start()])
+        last = match.end()
+        flags, width, precision, _, conv = match.groups()
+        if conv == '%':
+            out.append('%')
+            continue
+        if truncated:
+            out.append('<?>')
+            continue
+        try:
+            if width == '*':
+                width = str(reader.zigzag())
+            if precision == '*':
+                precision = str(reader.zigzag())
+            spec = '%' + flags.replace("'", '') + (width or '') + ('.' + precision if precision is not None else '')
+            if conv in 'di':
+                out.append((spec + 'd') % reader.zigzag())
+            elif conv == 'u':
+                out.append((spec + 'd') % reader.varint())
+            elif conv in 'oxX':
+                out.append((spec + conv) % reader.varint())
+            elif conv == 'c':
+                out.append((spec + 'c') % chr(reader.varint() & 0xFF))
+            elif conv == 'p':
+                out.append((spec + 's') % hex(reader.varint()))
+            elif conv in 'aA':
+                value = reader.double().hex()
+                out.append((spec + 's') % (value.upper() if conv == 'A' else value))
+            elif conv in 'fFeEgG':
+                out.append((spec + conv) % reader.double())
+            elif conv == 's':
+                out.append((spec + 's') % reader.string())
+        except EOFError:
+            truncated = True
+            out.append('<?>')
+    out.append(fmt[last:])
+
+    return ''.join(out)
+
+
+def render_frame(sites, payload):
+    reader = PayloadReader(payload)
+    site_id = reader.zigzag()
+    site = sites.get(str(site_id))
+    if site is None:
+        return '<unknown log site {}, is the dictionary up to date?>'.format(site_id)
+
+    level = site['level']
+    level_char = LEVEL_CHARS[level] if level < len(LEVEL_CHARS) else '?'
+    if site['flags'] & FLAG_RUNTIME_TAG:
+        try:
+            tag = reader.string()
+        except EOFError:
+            tag = '?'
+        return '[{}][{}]{}'.format(level_char, tag, format_message(site['format'], reader))
+
+    return '[{}][{}][{}:{:04d}]({}): {}'.format(
+        level_char, site['tag'], os.path.basename(site['file'] or '?'), site['line'], site['func'] or '?',
+        format_message(site['format'], reader)
+    )
+
+
+class StreamDecoder:
+    """Split a byte stream into raw text and frames, frames with an invalid checksum are passed through as raw bytes"""
+
+    def __init__(self, sites):
+        self.sites = sites
+        self.buffer = bytearray()
+
+    @staticmethod
+    def _unescape(data, start):
+        out = bytearray()
+        pos = start
+        while pos < len(data):
+            byte = data[pos]
+            if byte == SYNC:
+                return out, pos, True
+            if byte == ESCAPE:
+                if pos + 1 >= len(data):
+                    break
+                out.append(data[pos + 1] ^ ESCAPE_XOR)
+                pos += 2
+            else:
+                out.append(byte)
+                pos += 1
+            # length + payload + checksum
+            if len(out) >= 2 and len(out) == out[0] + 2:
+                return out, pos, True
+        return out, pos, False
+
+    def feed(self, data):
+        """Return a list of (is_frame, text)"""
+        self.buffer += data
+        results = []
+        while self.buffer:
+            start = self.buffer.find(bytes([SYNC]))
+            if start < 0:
+                results.append((False, self.buffer.decode('utf-8', errors='replace')))
+                self.buffer.clear()
+                break
+            if start > 0:
+                results.append((False, self.buffer[:start].decode('utf-8', errors='replace')))
+                del self.buffer[:start]
+            frame, end, complete = self._unescape(self.buffer, 1)
+            if not complete:
+                # Wait for more data
+                break
+            if len(frame) >= 2 and len(frame) == frame[0] + 2 and (sum(frame[1:-1]) & 0xFF) == frame[-1]:
+                results.append((True, render_frame(self.sites, bytes(frame[1:-1]))))
+                del self.buffer[:end]
+            else:
+                results.append((False, self.buffer[:1].decode('utf-8', errors='replace')))
+                del self.buffer[:1]
+        return results
+
+    def flush(self):
+        """Return the pending bytes of an incomplete frame as raw text"""
+        text = self.buffer.decode('utf-8', errors='replace')
+        self.buffer.clear()
+        return [(False, text)] if text else []
+
+
+def decode_stream(sites, read_chunk, out):
+    """Decode until `read_chunk()` returns None"""
+    decoder = StreamDecoder(sites)
+    at_line_start = True
+    while True:
+        chunk = read_chunk()
+        results = decoder.flush() if chunk is None else decoder.feed(chunk)
+        for is_frame, text in results:
+            if is_frame and not at_line_start:
+                out.write('\n')
+            out.write(text + ('\n' if is_frame else ''))
+            if text:
+                at_line_start = is_frame or text.endswith('\n')
+        out.flush()
+        if chunk is None:
+            break
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Dictionary-based log encoding tool')
+    subparsers = parser.add_subparsers(dest='command')
+    subparsers.required = True
+
+    extract_parser = subparsers.add_parser('extract', help='Extract the log dictionary from an ELF file')
+    extract_parser.add_argument('elf', help='Application ELF file')
+    extract_parser.add_argument('-o', '--output', help='Output JSON file, default is stdout')
+
+    decode_parser = subparsers.add_parser('decode', help='Decode a log stream')
+    source = decode_parser.add_mutually_exclusive_group(required=True)
+    source.add_argument('--elf', help='Application ELF file')
+    source.add_argument('--dict', help='Dictionary JSON file generated by `extract`')
+    decode_parser.add_argument('input', nargs='?', help='Captured stream file, default is stdin')
+    decode_parser.add_argument('--port', help='Read from a serial port instead (requires pyserial)')
+    decode_parser.add_argument('--baud', type=int, default=115200, help='Baud rate of the serial port')
+
+    args = parser.parse_args()
+
+    if args.command == 'extract':
+        dictionary = extract_dictionary(args.elf)
+        if args.output:
+            with open(args.output, 'w') as f:
+                json.dump(dictionary, f, indent=1)
+        else:
+            json.dump(dictionary, sys.stdout, indent=1)
+        return
+
+    if args.elf:
+        sites = extract_dictionary(args.elf)['sites']
+    else:
+        with open(args.dict, 'r') as f:
+            sites = json.load(f)['sites']
+
+    if args.port:
+        import serial
+        with serial.Serial(args.port, args.baud, timeout=0.1) as port:
+            decode_stream(sites, lambda: port.read(port.in_waiting or 1), sys.stdout)
+    elif args.input:
+        with open(args.input, 'rb') as f:
+            decode_stream(sites, lambda: f.read(4096) or None, sys.stdout)
+    else:
+        decode_stream(sites, lambda: sys.stdin.buffer.read1(4096) or None, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()
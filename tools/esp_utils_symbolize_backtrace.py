@@ -0,0 +1,150 @@
+# SPDX-FileCopyrightText: 2025 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Host side of the check failure backtraces (`ESP_UTILS_CONF_CHECK_ENABLE_BACKTRACE`).
+
+Symbolize the output of `esp_utils_check_backtrace_dump()` or `esp_utils_check_backtrace_export()` (other lines are
+passed through unchanged):
+    python esp_utils_symbolize_backtrace.py --elf build/app.elf capture.txt
+    python esp_utils_symbolize_backtrace.py --elf build/app.elf --port /dev/ttyUSB0 --baud 115200
+
+The addresses are resolved by `addr2line` of the target toolchain (found in `PATH`, or given by `--addr2line`), with a
+fallback to the ELF symbol table. Position-independent executables are relocated using the `anchor` line.
+"""
+
+import argparse
+import bisect
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from esp_utils_log_dict import ElfFile  # noqa: E402
+
+ANCHOR_SYMBOL = 'esp_utils_check_backtrace_capture'
+ANCHOR_RE = re.compile(r'ESP_UTILS_BT anchor=0x([0-9a-fA-F]+)')
+RECORD_RE = re.compile(r'ESP_UTILS_BT #(\d+) t=(\d+) (\S+) (\S+):(\d+) bt=((?:0x[0-9a-fA-F]+ ?)*)')
+
+EM_XTENSA = 94
+EM_RISCV = 243
+ADDR2LINE_CANDIDATES = {
+    EM_XTENSA: ['xtensa-esp-elf-addr2line', 'xtensa-esp32-elf-addr2line', 'xtensa-esp32s3-elf-addr2line'],
+    EM_RISCV: ['riscv32-esp-elf-addr2line'],
+}
+
+
+class Symbolizer:
+
+    def __init__(self, elf_path, addr2line=None):
+        self.elf_path = elf_path
+        elf = ElfFile(elf_path)
+        functions = sorted((value, size, name) for name, value, size in elf.symbols() if size > 0)
+        self.starts = [value for value, _, _ in functions]
+        self.functions = functions
+        self.anchor = next((value for value, _, name in functions if name == ANCHOR_SYMBOL), None)
+        if self.anchor is None:
+            raise ValueError('Symbol `{}` not found, is the check backtrace enabled?'.format(ANCHOR_SYMBOL))
+        self.addr2line = addr2line or self._find_addr2line(elf.machine)
+        self.offset = 0
+
+    @staticmethod
+    def _find_addr2line(machine):
+        for name in ADDR2LINE_CANDIDATES.get(machine, []) + ['addr2line']:
+            path = shutil.which(name)
+            if path:
+                return path
+        return None
+
+    def set_anchor(self, runtime_anchor):
+        self.offset = runtime_anchor - self.anchor
+
+    def _lookup_symbol(self, addr):
+        index = bisect.bisect_right(self.starts, addr) - 1
+        if index >= 0:
+            value, size, name = self.functions[index]
+            if addr < value + size:
+                return '{}+0x{:x}'.format(name, addr - value)
+        return '??'
+
+    def resolve(self, addresses):
+        """Return a description for each runtime address"""
+        addresses = [addr - self.offset for addr in addresses]
+        if self.addr2line and addresses:
+            try:
+                output = subprocess.run(
+                    [self.addr2line, '-pfiaC', '-e', self.elf_path] + ['0x{:x}'.format(addr) for addr in addresses],
+                    check=True, stdout=subprocess.PIPE, universal_newlines=True,
+                ).stdout
+                return self._split_addr2line(output, len(addresses))
+            except (OSError, subprocess.CalledProcessError):
+                pass
+        return [self._lookup_symbol(addr) for addr in addresses]
+
+    @staticmethod
+    def _split_addr2line(output, count):
+        # Each address starts a new entry with `-a`, inlined callers follow it on lines starting with spaces
+        results = []
+        for line in output.splitlines():
+            if line.startswith('0x') and ': ' in line:
+                results.append(line.split(': ', 1)[1])
+            elif results:
+                results[-1] += '\n        ' + line.strip()
+        return results if len(results) == count else results + ['??'] * (count - len(results))
+
+
+def symbolize_line(symbolizer, line):
+    match = ANCHOR_RE.search(line)
+    if match:
+        symbolizer.set_anchor(int(match.group(1), 16))
+        return None
+
+    match = RECORD_RE.search(line)
+    if not match:
+        return line
+
+    seq, timestamp, tag, file, line_number, frames = match.groups()
+    addresses = [int(frame, 16) for frame in frames.split()]
+    timestamp = int(timestamp)
+    out = ['Check failed #{} at {}.{:06d}s [{}] {}:{}'.format(
+        seq, timestamp // 1000000, timestamp % 1000000, tag, file, line_number
+    )]
+    for i, (addr, description) in enumerate(zip(addresses, symbolizer.resolve(addresses))):
+        out.append('    #{} 0x{:x} in {}'.format(i, addr, description))
+    return '\n'.join(out) + '\n'
+
+
+def symbolize_stream(symbolizer, lines, out):
+    for line in lines:
+        result = symbolize_line(symbolizer, line)
+        if result is not None:
+            out.write(result)
+            out.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Check failure backtrace symbolizer')
+    parser.add_argument('--elf', required=True, help='Application ELF file')
+    parser.add_argument('--addr2line', help='addr2line executable, default is searched in PATH by the ELF machine')
+    parser.add_argument('input', nargs='?', help='Captured output file, default is stdin')
+    parser.add_argument('--port', help='Read from a serial port instead (requires pyserial)')
+    parser.add_argument('--baud', type=int, default=115200, help='Baud rate of the serial port')
+
+    args = parser.parse_args()
+    symbolizer = Symbolizer(args.elf, args.addr2line)
+
+    if args.port:
+        import serial
+        with serial.Serial(args.port, args.baud) as port:
+            symbolize_stream(symbolizer, (raw.decode('utf-8', errors='replace') for raw in port), sys.stdout)
+    elif args.input:
+        with open(args.input, 'r', errors='replace') as f:
+            symbolize_stream(symbolizer, f, sys.stdout)
+    else:
+        symbolize_stream(symbolizer, sys.stdin, sys.stdout)
+
+
+if __name__ == '__main__':
+    main()